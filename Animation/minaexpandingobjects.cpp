@@ -133,7 +133,7 @@ void MinaExpandingObjects::createItem(const unsigned int uppqn, const QColor &co
     }
 
     const unsigned int duration = _beatDuration->loopSizeInPpqn();
-    MinoAnimatedItem maItem (uppqn, duration, item);
+    MinoAnimatedItem maItem (uppqn, duration, item, _notePhase);
     _itemGroup.addToGroup(item);
     _animatedItems.append(maItem);
 }
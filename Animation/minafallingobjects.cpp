@@ -21,6 +21,7 @@
 #include "minafallingobjects.h"
 
 #include <QDebug>
+#include <QVarLengthArray>
 
 #include "minoanimationgroup.h"
 
@@ -71,7 +72,7 @@ void MinaFallingObjects::_createItem(const uint uppqn)
 
     if(direction == 4)
     {
-        direction = qrand() % 4;
+        direction = _random.bounded(4);
     }
 
     switch (direction)
@@ -86,6 +87,10 @@ void MinaFallingObjects::_createItem(const uint uppqn)
         break;
     }
 
+    // One random offset per item
+    QVarLengthArray<qreal> offsets(density);
+    _random.fillReal(offsets.data(), density);
+
     for (unsigned int i=0;i<density;i++)
     {
         const qreal progress = (qreal)i/(qreal)density;
@@ -96,7 +101,7 @@ void MinaFallingObjects::_createItem(const uint uppqn)
             case 1:
             {
                 //Horizontal
-                pos = (qreal)((progress + (qrandF()*step))*_boundingRect.height());
+                pos = (qreal)((progress + (offsets[i]*step))*_boundingRect.height());
                 createItem(uppqn, _color->color(), pos, direction);
             }
             break;
@@ -104,7 +109,7 @@ void MinaFallingObjects::_createItem(const uint uppqn)
             case 3:
             {
                 //Vertical
-                pos = (qreal)((progress + (qrandF()*step))*_boundingRect.width());
+                pos = (qreal)((progress + (offsets[i]*step))*_boundingRect.width());
                 createItem(uppqn, _color->color(), pos, direction);
             }
             break;
@@ -167,7 +172,7 @@ void MinaFallingObjects::createItem(const uint uppqn, const QColor& color, const
     }
 
     item->setData(MinaFallingObjects::Direction, direction);
-    MinoAnimatedItem maItem (uppqn, duration, item);
+    MinoAnimatedItem maItem (uppqn, duration, item, _notePhase);
     _itemGroup.addToGroup(item);
     _animatedItems.append(maItem);
 }
@@ -243,7 +248,7 @@ void MinaFallingObjects::_startNote(const uint uppqn, const quint8 note, const q
     unsigned int direction = _generatorDirection->currentItem()->real();
     if(direction == 4)
     {
-        direction = qrand() % 4;
+        direction = _random.bounded(4);
     }
     unsigned int pos = 0;
     switch (direction)
@@ -58,3 +58,11 @@ void MinaFlash::animate(const unsigned int uppqn, const unsigned int gppqn, cons
     _rectItem->setBrush(QBrush(color));
     _rectItem->setOpacity(_ecrOpacity.valueForProgress(_beatFactor->progressForGppqn(gppqn)));
 }
+
+bool MinaFlash::isOpaque() const
+{
+    return _rectItem->isVisible()
+            && (_rectItem->opacity() >= 1.0)
+            && _rectItem->brush().isOpaque()
+            && _rectItem->rect().contains(QRectF(_boundingRect));
+}
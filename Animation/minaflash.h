@@ -34,6 +34,7 @@ public:
     explicit MinaFlash(QObject *object);
     ~MinaFlash();
     void animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn);
+    bool isOpaque() const;
 
     static const MinoAnimationDescription getDescription() {
         return MinoAnimationDescription("Flash", "Beat-sync flash", QPixmap(":/images/flash.png"), MinaFlash::staticMetaObject.className());
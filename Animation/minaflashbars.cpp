@@ -55,7 +55,7 @@ void MinaFlashBars::createItem(const uint uppqn, const QColor& color, const unsi
     const unsigned int duration = _beatDuration->loopSizeInPpqn();
     item = _scene->addRect(0, pos, _boundingRect.width(), _width->value()*_boundingRect.height(), QPen(Qt::NoPen),QBrush(color));
     item->setData(MinaFlashBars::Color, color);
-    MinoAnimatedItem maItem (uppqn, duration, item);
+    MinoAnimatedItem maItem (uppqn, duration, item, _notePhase);
     _itemGroup.addToGroup(item);
     _animatedItems.append(maItem);
 }
@@ -96,7 +96,7 @@ void MinaGrid::createItem(const uint uppqn, const QColor& color, const unsigned
     qreal itemHeight = (qreal)_boundingRect.height()/itemsY;
     item = _scene->addRect(x*itemWidth, y*itemHeight, itemWidth, itemHeight, QPen(Qt::NoPen),QBrush(QColor(127,127,0)));
     item->setData(MinaGrid::Color, color);
-    MinoAnimatedItem maItem (uppqn, duration, item);
+    MinoAnimatedItem maItem (uppqn, duration, item, _notePhase);
     _itemGroup.addToGroup(item);
     _animatedItems.append(maItem);
 }
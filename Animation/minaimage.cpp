@@ -18,57 +18,43 @@
  * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "minaimage.h"
 
-#include <QGraphicsProxyWidget>
+#include <QImageReader>
 #include <QDebug>
 
-ImageWidget::ImageWidget(QWidget *parent) :
-    QWidget(parent)
-{
-    setAttribute(Qt::WA_StaticContents, true);
-    setAttribute(Qt::WA_OpaquePaintEvent, true);
-    setAttribute(Qt::WA_NoSystemBackground, true);
-}
+#include <cstring>
 
-void ImageWidget::paintEvent(QPaintEvent *)
-{
-    QPainter painter(this);
-    painter.drawImage(QPointF(), _image);
-}
+#if QT_VERSION >= 0x050000
+#include <QtConcurrent/QtConcurrentRun>
+#else
+#include <QtConcurrentRun>
+#endif
 
-void ImageWidget::resizeEvent(QResizeEvent *)
-{
-    // Dirty rescale of previously saved image
-    if(!_image.isNull())
-        _image = _image.scaled(size(),Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
-}
-
-void ImageWidget::setImage(QImage *image)
-{
-    if(image->isNull())
-        _image = *image;
-    else
-        _image = image->scaled(size(),Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
-}
+#include "minotor.h"
 
 MinaImage::MinaImage(QObject *parent) :
     MinoAnimation(parent),
-    _imageIndex(0)
+    _imageIndex(0),
+    _frameCount(0),
+    _changed(true),
+    _framesPending(false)
 {
     // Color is not usable in this animation
     delete _color;
     _color = NULL;
 
-    _imageWidget = new ImageWidget();
-    _imageWidget->resize(_boundingRect.size());
-
-    _itemGroup.addToGroup(_scene->addWidget(_imageWidget));
+    _imageItem = new MinoImageItem(_boundingRect.size());
+    _itemGroup.addToGroup(_imageItem);
 
     _generatorCurve = new MinoPropertyEasingCurve(this, true);
     _generatorCurve->setObjectName("curve");
     _generatorCurve->setLabel("Curve");
 
+    connect(&_framesLoader, SIGNAL(finished()), this, SLOT(framesLoaded()));
+    connect(Minotor::minotor(), SIGNAL(rendererSizeChanged()), this, SLOT(updateRendererSize()));
+
     _imageFilename = new MinoPropertyFilename(this);
     connect(_imageFilename, SIGNAL(filenameChanged(QString)), SLOT(loadFromFile(QString)));
     _imageFilename->setFilename("spaceinvader.gif");
@@ -76,32 +62,92 @@ MinaImage::MinaImage(QObject *parent) :
 
 MinaImage::~MinaImage()
 {
-    foreach(QImage* i, _imageList)
-    {
-        delete i;
-    }
-    _imageList.clear();
 }
 
-void MinaImage::loadFromFile(const QString& filename)
+QImage MinaImage::decodeFrames(const QString &filename, const QSize &size)
 {
     QImageReader ir;
     ir.setFileName(filename);
 
-    if(ir.canRead())
+    QList<QImage> frames;
+    while(ir.canRead())
     {
-        foreach(QImage* i, _imageList)
+        const QImage frame = ir.read();
+        if(frame.isNull())
+            break;
+        // Only one full-size frame is kept decoded at a time
+        frames.append(frame.scaled(size,Qt::IgnoreAspectRatio,Qt::SmoothTransformation)
+                      .convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    }
+
+    if(frames.isEmpty())
+        return QImage();
+
+    QImage sheet(size.width(), size.height()*frames.count(), QImage::Format_ARGB32_Premultiplied);
+    const int lineSize = size.width() * sizeof(QRgb);
+    for(int i=0; i<frames.count(); i++)
+    {
+        const QImage &frame = frames.at(i);
+        for(int y=0; y<size.height(); y++)
         {
-            delete i;
+            memcpy(sheet.scanLine((i*size.height())+y), frame.constScanLine(y), lineSize);
         }
-        _imageList.clear();
+    }
+    return sheet;
+}
 
-        while(ir.canRead())
-            _imageList.append(new QImage(ir.read()));
+void MinaImage::loadFromFile(const QString& filename)
+{
+    if(!_boundingRect.size().isValid())
+        return;
+    _framesLoaderSize = _boundingRect.size();
+    _framesPending = true;
+    _framesLoader.setFuture(QtConcurrent::run(&MinaImage::decodeFrames, filename, _framesLoaderSize));
+}
+
+void MinaImage::waitForFrames()
+{
+    if(!_framesPending)
+        return;
+    _framesLoader.waitForFinished();
+    framesLoaded();
+}
 
-        if(_imageList.count())
-            _imageWidget->setImage(_imageList.at(0));
+void MinaImage::framesLoaded()
+{
+    // Already taken by waitForFrames()
+    if(!_framesPending)
+        return;
+    _framesPending = false;
+    const QImage frames = _framesLoader.result();
+    if(frames.isNull() || (_framesLoaderSize != _boundingRect.size()))
+    {
+        // Unreadable file or renderer size changed meanwhile: keep current frames
+        return;
     }
+    _frames = frames;
+    _frameCount = _frames.height() / _boundingRect.height();
+    _imageIndex = 0;
+    showFrame(_imageIndex);
+}
+
+void MinaImage::updateRendererSize()
+{
+    _boundingRect = Minotor::minotor()->displayRect();
+    _imageItem->setSize(_boundingRect.size());
+    _changed = true;
+    loadFromFile(_imageFilename->filename());
+}
+
+void MinaImage::showFrame(const int index)
+{
+    // No copy: item directly displays the frame from the sheet
+    const int height = _boundingRect.height();
+    _imageItem->setBuffer(_frames.constScanLine(index*height),
+                          QSize(_frames.width(), height),
+                          _frames.bytesPerLine(),
+                          _frames.format());
+    _changed = true;
 }
 
 void MinaImage::animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn)
@@ -110,20 +156,17 @@ void MinaImage::animate(const unsigned int uppqn, const unsigned int gppqn, cons
     (void)ppqn;
     (void)qn;
 
-    if(_imageList.count())
+    if(_frameCount > 1)
     {
-        if(_imageList.count() != 1)
+        QEasingCurve ecImageIndex(_generatorCurve->easingCurveType());
+        const qreal pos = ecImageIndex.valueForProgress(_beatFactor->progressForGppqn(gppqn));
+        int imageIndex = (pos*0.999999999*_frameCount);
+        if(imageIndex>=_frameCount)
+            imageIndex = _frameCount-1;
+        if(_imageIndex != imageIndex)
         {
-            QEasingCurve ecImageIndex(_generatorCurve->easingCurveType());
-            const qreal pos = ecImageIndex.valueForProgress(_beatFactor->progressForGppqn(gppqn));
-            int imageIndex = (pos*0.999999999*_imageList.count());
-            if(imageIndex>=_imageList.count())
-                imageIndex = _imageList.count()-1;
-            if(_imageIndex != imageIndex)
-            {
-                _imageIndex = imageIndex;
-                _imageWidget->setImage(_imageList.at(_imageIndex));
-            }
+            _imageIndex = imageIndex;
+            showFrame(_imageIndex);
         }
     }
 }
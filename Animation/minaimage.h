@@ -23,31 +23,13 @@
 
 #include "minoanimation.h"
 
-#include <QWidget>
-#include <QPainter>
 #include <QImage>
-#include <QImageReader>
+#include <QFutureWatcher>
 
+#include "minoimageitem.h"
 #include "minopropertyeasingcurve.h"
 #include "minopropertyfilename.h"
 
-class ImageWidget : public QWidget
-{
-    Q_OBJECT
-
-public:
-    explicit ImageWidget(QWidget *parent = 0);
-
-    void setImage(QImage *image);
-
-protected:
-    virtual void paintEvent(QPaintEvent *);
-    virtual void resizeEvent(QResizeEvent *);
-
-private:
-    QImage _image;
-};
-
 class MinaImage : public MinoAnimation
 {
     Q_OBJECT
@@ -63,20 +45,40 @@ public:
     }
     const MinoAnimationDescription description() const { return getDescription(); }
     QGraphicsItem* graphicItem() { return &_itemGroup; }
+    bool takeChanged() { const bool changed = _changed; _changed = false; return changed; }
 
 signals:
     
 public slots:
     void loadFromFile(const QString& filename);
+public:
+    // Frames decoding is done in background and delivered through event loop: this waits for it
+    void waitForFrames();
+
+private slots:
+    void framesLoaded();
+    void updateRendererSize();
 
 private:
     QGraphicsItemGroup _itemGroup;
-    ImageWidget *_imageWidget;
-    QList<QImage*> _imageList;
+    MinoImageItem *_imageItem;
     int _imageIndex;
     MinoPropertyEasingCurve *_generatorCurve;
     MinoPropertyFilename *_imageFilename;
 
+    // All frames, pre-scaled to display size, stacked vertically in a single image
+    QImage _frames;
+    int _frameCount;
+    // Displayed frame or item size changed since last takeChanged()
+    bool _changed;
+    void showFrame(const int index);
+
+    // Frames are decoded and scaled in background (ie. not in clock's thread)
+    QFutureWatcher<QImage> _framesLoader;
+    QSize _framesLoaderSize;
+    // Decoding started and its result not yet taken by framesLoaded()
+    bool _framesPending;
+    static QImage decodeFrames(const QString &filename, const QSize &size);
 };
 
 #endif // MINAIMAGE_H
@@ -36,6 +36,8 @@ public:
     explicit MinaPlasma(QObject *object);
     ~MinaPlasma();
     void animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn);
+    // Background gradient covers bounding rect
+    bool isOpaque() const { return _itemGroup.isVisible() && _rectBackground->isVisible() && _rectBackground->brush().isOpaque(); }
 
     static const MinoAnimationDescription getDescription() {
         return MinoAnimationDescription("Plasma", "Strange thing ;-)", QPixmap(":/images/plasma.png"), MinaPlasma::staticMetaObject.className());
@@ -20,38 +20,16 @@
 
 #include "minarainbowoil.h"
 
-#include <QGraphicsProxyWidget>
 #include <QDebug>
 #include <cmath>
 
-OilImageWidget::OilImageWidget(QWidget *parent) :
-    QWidget(parent),
-    _image(NULL)
-{
-    setAttribute(Qt::WA_StaticContents, true);
-    setAttribute(Qt::WA_OpaquePaintEvent, true);
-    setAttribute(Qt::WA_NoSystemBackground, true);
-}
-
-void OilImageWidget::paintEvent(QPaintEvent *)
-{
-    QPainter painter(this);
-    if(_image)
-        painter.drawImage(QPointF(), *_image);
-}
-
-void OilImageWidget::setImage(QImage *image)
-{
-    _image = image;
-}
-
 MinaRainbowOil::MinaRainbowOil(QObject *parent) :
     MinoAnimation(parent)
 {
-    _oilImageWidget = new OilImageWidget();
-    _image = new QImage(_boundingRect.size(), QImage::Format_ARGB32);
-
-    _itemGroup.addToGroup(_scene->addWidget(_oilImageWidget));
+    // Image is rendered in place in item's own buffer
+    _imageItem = new MinoImageItem(_boundingRect.size());
+    _imageItem->setImage(QImage(_boundingRect.size(), QImage::Format_ARGB32));
+    _itemGroup.addToGroup(_imageItem);
 
     _style = new MinoItemizedProperty(this);
     _style->setObjectName("style");
@@ -82,8 +60,6 @@ MinaRainbowOil::MinaRainbowOil(QObject *parent) :
 
 MinaRainbowOil::~MinaRainbowOil()
 {
-    delete _image;
-    delete _oilImageWidget;
 }
 
 void MinaRainbowOil::renderImage(const qreal pos, const qreal hue, const qreal light, QImage *image)
@@ -149,6 +125,6 @@ void MinaRainbowOil::animate(const unsigned int uppqn, const unsigned int gppqn,
         break;
     }
 
-    renderImage(pos, _color->color().hueF(), _color->color().lightnessF(), _image);
-    _oilImageWidget->setImage(_image);
+    renderImage(pos, _color->color().hueF(), _color->color().lightnessF(), _imageItem->image());
+    _imageItem->update();
 }
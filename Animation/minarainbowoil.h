@@ -23,31 +23,13 @@
 
 #include "minoanimation.h"
 
-#include <QWidget>
-#include <QPainter>
 #include <QImage>
 
+#include "minoimageitem.h"
 #include "minopropertyreal.h"
 #include "minopropertyeasingcurve.h"
 #include "minoitemizedproperty.h"
 
-class OilImageWidget : public QWidget
-{
-    Q_OBJECT
-
-public:
-    explicit OilImageWidget(QWidget *parent = 0);
-
-    void setImage(QImage *image);
-
-protected:
-    virtual void paintEvent(QPaintEvent *);
-
-private:
-    QImage *_image;
-};
-
-
 class MinaRainbowOil : public MinoAnimation
 {
     Q_OBJECT
@@ -72,14 +54,13 @@ protected:
     
 private:
     QGraphicsItemGroup _itemGroup;
-    OilImageWidget *_oilImageWidget;
+    MinoImageItem *_imageItem;
     MinoPropertyEasingCurve *_generatorCurve;
     MinoItemizedProperty *_style;
     MinoPropertyReal *_mprSpeed;
     MinoPropertyReal *_mprBoost;
     MinoPropertyReal *_mprStep;
 
-    QImage *_image;
     qreal _pos;
 
 };
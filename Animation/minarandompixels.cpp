@@ -21,6 +21,8 @@
 #include "minarandompixels.h"
 
 #include <QDebug>
+#include <QVarLengthArray>
+#include <qmath.h>
 
 MinaRandomPixels::MinaRandomPixels(QObject *object) :
     MinoInstrumentedAnimation(object)
@@ -48,13 +50,19 @@ void MinaRandomPixels::createPixels(const unsigned int uppqn, const unsigned dur
     QEasingCurve ec(QEasingCurve::InExpo);
     const qreal pixelCount = (ec.valueForProgress(_density->value())*((_boundingRect.width()*_boundingRect.height())-1))+1;
 
-    for(int i=0; i<pixelCount; i++)
+    // Pixels coordinates (x,y pairs in range [0-1[)
+    const int count = qCeil(pixelCount);
+    QVarLengthArray<qreal> coordinates(count*2);
+    _random.fillReal(coordinates.data(), count*2);
+
+    for(int i=0; i<count; i++)
     {
-        const QPointF rand = qrandPointF();
+        const qreal x = coordinates[i*2] * _boundingRect.width();
+        const qreal y = coordinates[(i*2)+1] * _boundingRect.height();
         const qreal h = 0.1;
-        QGraphicsLineItem *gli = _scene->addLine(rand.x(), rand.y(), rand.x()+h, rand.y()+h, QPen(color));
+        QGraphicsLineItem *gli = _scene->addLine(x, y, x+h, y+h, QPen(color));
         _itemGroup.addToGroup(gli);
-        MinoAnimatedItem maItem (uppqn, duration, gli);
+        MinoAnimatedItem maItem (uppqn, duration, gli, _notePhase);
         _animatedItems.append(maItem);
     }
 }
@@ -74,7 +74,7 @@ void MinaStars::createItem(const unsigned int uppqn, const QColor& color)
         group->addToGroup(item);
     }
     group->setTransformOriginPoint(_boundingRect.center());
-    MinoAnimatedItem maItem (uppqn, duration, group);
+    MinoAnimatedItem maItem (uppqn, duration, group, _notePhase);
     _animatedItems.append(maItem);
 }
 
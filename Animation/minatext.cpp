@@ -19,10 +19,13 @@
  */
 
 #include "minatext.h"
-#include <QLabel>
+
+#include "minoglyphatlas.h"
+#include "minoimageitem.h"
 
 MinaText::MinaText(QObject *object) :
-    MinoAnimation(object)
+    MinoAnimation(object),
+    _changed(true)
 {
     _ecrScale.setStartValue(1.0);
     _ecrScale.setEndValue(0.01);
@@ -43,6 +46,13 @@ MinaText::MinaText(QObject *object) :
     _generatorStyle->addItem("P:R T:R", 4);
     _generatorStyle->setCurrentItemFromString("P:R T:F");
 
+    _font = new MinoItemizedProperty(this);
+    _font->setObjectName("font");
+    _font->setLabel("Font");
+    _font->addItem("Arial", 0);
+    _font->addItem("Pixel 5x7", 1);
+    _font->setCurrentItemFromString("Arial");
+
     _generatorCurve = new MinoPropertyEasingCurve(this, true);
     _generatorCurve->setObjectName("curve");
     _generatorCurve->setLabel("Curve");
@@ -59,12 +69,18 @@ void MinaText::animate(const unsigned int uppqn, const unsigned int gppqn, const
 
     if (_beatFactor->isBeat(gppqn))
     {
-        QGraphicsTextItem* item = _scene->addText(_text->text(),QFont("Arial",12,QFont::Bold,false));
+        // Rasterized text is shared through glyph atlas cache
+        QImage image;
+        if(_font->currentItem()->real() == 1)
+            image = MinoGlyphAtlas::atlas()->pixelText(_text->text(), color);
+        else
+            image = MinoGlyphAtlas::atlas()->text(_text->text(), QFont("Arial",12,QFont::Bold,false), color);
+        MinoImageItem *item = new MinoImageItem(image.size());
+        item->setImage(image);
         QRectF tRect = item->boundingRect();
         tRect.adjust(0,0,-1,-1);
         tRect.moveCenter(_boundingRect.center());
         item->setPos(tRect.topLeft());
-        item->setDefaultTextColor(color);
 
         const unsigned int style = _generatorStyle->currentItem()->real();
         switch(style)
@@ -104,6 +120,7 @@ void MinaText::animate(const unsigned int uppqn, const unsigned int gppqn, const
         MinoAnimatedItem maItem (uppqn, duration, item);
         _itemGroup.addToGroup(item);
         _animatedItems.append(maItem);
+        _changed = true;
 
     }
     for (int i=_animatedItems.count()-1;i>-1;i--)
@@ -113,11 +130,18 @@ void MinaText::animate(const unsigned int uppqn, const unsigned int gppqn, const
         {
             delete item._graphicsItem;
             _animatedItems.removeAt(i);
+            _changed = true;
         }
         else
         {
             const qreal progress = item.progressForUppqn(uppqn);
-            _animatedItems.at(i)._graphicsItem->setScale(_ecrScale.valueForProgress(progress));
+            const qreal scale = _ecrScale.valueForProgress(progress);
+            // Completed items are held at their final scale until removed
+            if(item._graphicsItem->scale() != scale)
+            {
+                item._graphicsItem->setScale(scale);
+                _changed = true;
+            }
         }
     }
 }
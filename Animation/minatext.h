@@ -42,6 +42,7 @@ public:
     const MinoAnimationDescription description() const { return getDescription(); }
     
     QGraphicsItem* graphicItem() { return &_itemGroup; }
+    bool takeChanged() { const bool changed = _changed; _changed = false; return changed; }
 
 signals:
     
@@ -50,11 +51,14 @@ public slots:
 private:
     MinoPropertyBeat *_beatDuration;
     MinoItemizedProperty *_generatorStyle;
+    MinoItemizedProperty *_font;
     MinoPropertyText *_text;
     MinoPropertyEasingCurve *_generatorCurve;
     QGraphicsItemGroup _itemGroup;
     MinoAnimatedItems _animatedItems;
     EasingCurvedReal _ecrScale;
+    // Items have been created, destroyed or scaled since last takeChanged()
+    bool _changed;
 };
 
 #endif // MINATEXT_H
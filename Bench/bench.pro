@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#
+# Minotor benchmarks (JSON report on stdout)
+#
+#-------------------------------------------------
+
+QT       += core gui
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = minotor-bench
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../minotor.pri)
+
+SOURCES += \
+    main.cpp
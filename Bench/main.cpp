@@ -0,0 +1,312 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <QApplication>
+#include <QStringList>
+#include <QTextStream>
+#include <QElapsedTimer>
+
+#include "minotor.h"
+#include "minoprogram.h"
+#include "minoanimationgroup.h"
+#include "minopersistentobjectfactory.h"
+#include "minonulldevice.h"
+#include "midicontrollablelist.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+// Ticks used to let animations reach their steady state (not measured)
+#define BENCH_WARMUP_TICKS 96
+
+static void usage()
+{
+    QTextStream err(stderr);
+    err << "Usage: minotor-bench [--ticks <count>] [--pipeline <programs> <groups> <animations>]" << endl;
+    err << "  default mode measures every animation alone at several sizes" << endl;
+    err << "  --pipeline measures whole clock dispatch on a synthetic program bank" << endl;
+}
+
+// Returns peak resident set size in KiB (-1 if unknown)
+static long peakRssKb()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef Q_OS_MAC
+        return usage.ru_maxrss / 1024; // bytes on MacOS
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+static QString sizeToString(const QSize &size)
+{
+    return QString("%1x%2").arg(size.width()).arg(size.height());
+}
+
+// Drive one animation alone in its program and time animate/render separately
+static QString benchAnimation(Minotor *minotor, const QString &className, const int ticks)
+{
+    MinoProgramBank *bank = new MinoProgramBank(minotor);
+    MinoProgram *program = new MinoProgram(bank);
+    MinoAnimationGroup *group = new MinoAnimationGroup(program);
+    program->addAnimationGroup(group);
+    group->addAnimation(className);
+    group->setEnabled(true);
+    // No event loop is running: background setup (ie. image decoding) is waited for before timing
+    program->waitForFrames();
+
+    QElapsedTimer timer;
+    qint64 animateNs = 0;
+    qint64 renderNs = 0;
+    for(int i=0; i<BENCH_WARMUP_TICKS+ticks; i++)
+    {
+        const unsigned int uppqn = i;
+        const unsigned int gppqn = i%384;
+        const unsigned int ppqn = i%24;
+        const unsigned int qn = gppqn/24;
+
+        timer.start();
+        program->animate(uppqn, gppqn, ppqn, qn);
+        const qint64 animated = timer.nsecsElapsed();
+        program->render();
+        const qint64 rendered = timer.nsecsElapsed();
+
+        if(i >= BENCH_WARMUP_TICKS)
+        {
+            animateNs += animated;
+            renderNs += rendered - animated;
+        }
+    }
+    delete bank;
+
+    return QString("{\"animation\": \"%1\", \"size\": \"%2\", \"animate_ns\": %3, \"render_ns\": %4}")
+            .arg(className)
+            .arg(sizeToString(minotor->rendererSize()))
+            .arg(animateNs/ticks)
+            .arg(renderNs/ticks);
+}
+
+// Master crossfades to next program every 4 beats (when bank has several ones):
+// transitions (program going on-air and master blend) are part of measured frames, as in a show
+static void benchSwitchProgram(Minotor *minotor, MinoProgramBank *bank, const unsigned int gppqn)
+{
+    if((bank->programs().count() < 2) || ((gppqn % 96) != 0))
+        return;
+    MinoMaster *master = minotor->master();
+    const int next = (bank->programs().indexOf(master->program()) + 1) % bank->programs().count();
+    master->setProgram(bank->programs().at(next));
+}
+
+// Build a bank of programs x groups x animations and run the whole clock pipeline
+static QString benchPipeline(Minotor *minotor, const int programs, const int groups, const int animations, const int ticks)
+{
+    // Frames are sent to nowhere
+    MinoNullDevice sink;
+    sink.open(QIODevice::WriteOnly);
+    LedMatrix *ledMatrix = minotor->ledMatrix();
+    ledMatrix->setOutputDevice(&sink);
+    minotor->setRendererSize(ledMatrix->size());
+
+    const QList<MinoAnimationDescription> models = MinoPersistentObjectFactory::availableAnimationModels();
+    MinoProgramBank *bank = new MinoProgramBank(minotor);
+    int modelId = 0;
+    for(int p=0; p<programs; p++)
+    {
+        MinoProgram *program = new MinoProgram(bank);
+        for(int g=0; g<groups; g++)
+        {
+            MinoAnimationGroup *group = new MinoAnimationGroup(program);
+            program->addAnimationGroup(group);
+            for(int k=0; k<animations; k++)
+            {
+                group->addAnimation(models.at(modelId++ % models.count()).className());
+            }
+            group->setEnabled(true);
+        }
+        program->waitForFrames();
+    }
+    // First program goes on air
+    minotor->changeProgramBank(bank);
+
+    // Clock is running (transitions are only done with a running clock) but pulses come from this bench
+    MinoClockSource *clockSource = minotor->clockSource();
+    clockSource->setManual(true);
+    clockSource->uiStart();
+    MinoMaster *master = minotor->master();
+    MidiControllableList *transition = master->findChild<MidiControllableList*>("master-transition");
+    if(transition)
+        transition->setCurrentItemFromString("fade");
+
+    // Throughput: clock dispatching as in a show
+    QElapsedTimer timer;
+    int frames = 0;
+    timer.start();
+    for(int i=0; i<ticks; i++)
+    {
+        const unsigned int gppqn = i%384;
+        benchSwitchProgram(minotor, bank, gppqn);
+        minotor->dispatchClock(i, gppqn, gppqn%24, gppqn/24);
+        if((gppqn%2) == 0)
+            frames++;
+    }
+    const qint64 dispatchNs = timer.nsecsElapsed();
+
+    // Latency per stage: same path than Minotor::dispatchClock, step by step
+    // (on-air program, program going on-air during a transition, master blend, LED matrix output)
+    qint64 animateNs = 0;
+    qint64 renderNs = 0;
+    qint64 blendNs = 0;
+    qint64 mapNs = 0;
+    qint64 outputNs = 0;
+    for(int i=0; i<ticks; i++)
+    {
+        const unsigned int uppqn = ticks+i;
+        const unsigned int gppqn = i%384;
+        const unsigned int ppqn = gppqn%24;
+        benchSwitchProgram(minotor, bank, gppqn);
+        if((ppqn%2) != 0)
+            continue;
+        master->updateTransition(uppqn, ppqn);
+        if(!master->program())
+            continue;
+
+        timer.start();
+        master->program()->animate(uppqn, gppqn, ppqn, gppqn/24);
+        if(master->isInTransition())
+            master->nextProgram()->animate(uppqn, gppqn, ppqn, gppqn/24);
+        animateNs += timer.nsecsElapsed();
+        timer.start();
+        master->program()->render();
+        if(master->isInTransition())
+            master->nextProgram()->render();
+        renderNs += timer.nsecsElapsed();
+        timer.start();
+        const QImage *rendering = master->rendering();
+        blendNs += timer.nsecsElapsed();
+        timer.start();
+        ledMatrix->map(rendering);
+        mapNs += timer.nsecsElapsed();
+        timer.start();
+        ledMatrix->write();
+        outputNs += timer.nsecsElapsed();
+    }
+
+    clockSource->uiStop();
+    clockSource->setManual(false);
+    ledMatrix->setOutputDevice(NULL);
+
+    frames = qMax(1, frames);
+    return QString("{\"benchmark\": \"pipeline\", \"size\": \"%1\", \"programs\": %2, \"groups\": %3, \"animations\": %4, "
+                   "\"ticks\": %5, \"frames\": %6, \"dispatch_ns_per_frame\": %7, \"fps\": %8, "
+                   "\"stages_ns_per_frame\": {\"animate\": %9, \"render\": %10, \"blend\": %11, \"map\": %12, \"output\": %13}, "
+                   "\"output_bytes\": %14, \"peak_rss_kb\": %15}")
+            .arg(sizeToString(ledMatrix->size()))
+            .arg(programs).arg(groups).arg(animations)
+            .arg(ticks).arg(frames)
+            .arg(dispatchNs/frames)
+            .arg(dispatchNs?(frames*1000000000.0/dispatchNs):0.0)
+            .arg(animateNs/frames).arg(renderNs/frames).arg(blendNs/frames).arg(mapNs/frames).arg(outputNs/frames)
+            .arg(sink.totalBytesWritten())
+            .arg(peakRssKb());
+}
+
+int main(int argc, char *argv[])
+{
+#if QT_VERSION >= 0x050000
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication a(argc, argv);
+#else
+    QApplication a(argc, argv, false);
+#endif
+
+    int ticks = 384*4;
+    bool pipeline = false;
+    int programs = 0;
+    int groups = 0;
+    int animations = 0;
+    const QStringList args = a.arguments();
+    for(int i=1; i<args.count(); i++)
+    {
+        if((args.at(i) == "--ticks") && ((i+1) < args.count()))
+        {
+            ticks = qMax(1, args.at(++i).toInt());
+        }
+        else if((args.at(i) == "--pipeline") && ((i+3) < args.count()))
+        {
+            pipeline = true;
+            programs = qMax(1, args.at(++i).toInt());
+            groups = qMax(1, args.at(++i).toInt());
+            animations = qMax(1, args.at(++i).toInt());
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    // Auto-create minotor instance (registers animations)
+    Minotor *minotor = Minotor::minotor();
+
+    QTextStream out(stdout);
+    if(pipeline)
+    {
+        out << benchPipeline(minotor, programs, groups, animations, ticks) << endl;
+        delete Minotor::minotor();
+        return 0;
+    }
+
+    QList<QSize> sizes;
+    sizes << QSize(24,16) << QSize(64,32) << QSize(128,64) << QSize(256,128);
+
+    QStringList results;
+    foreach(const QSize &size, sizes)
+    {
+        // Animations and programs pick their drawing size at creation
+        minotor->setRendererSize(size);
+        foreach(const MinoAnimationDescription &model, MinoPersistentObjectFactory::availableAnimationModels())
+        {
+            results.append(benchAnimation(minotor, model.className(), ticks));
+            // Flush deferred deletions
+            a.processEvents();
+        }
+    }
+
+    out << "{" << endl
+        << "  \"benchmark\": \"animations\"," << endl
+        << "  \"ticks\": " << ticks << "," << endl
+        << "  \"results\": [" << endl
+        << "    " << results.join(",\n    ") << endl
+        << "  ]" << endl
+        << "}" << endl;
+
+    delete Minotor::minotor();
+
+    return 0;
+}
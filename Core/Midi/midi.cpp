@@ -21,11 +21,21 @@
 #include "midi.h"
 
 #include <QDebug>
+#if QT_VERSION >= 0x050000
+#include <QtConcurrent/QtConcurrentRun>
+#else
+#include <QtConcurrentRun>
+#endif
 
 #include "midiinterface.h"
+#include "mididevicewatcher.h"
+
+// Delay between a device notification and ports rescan
+#define MIDI_RESCAN_DELAY_MS 200
 
 Midi::Midi(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    _deviceWatcher(NULL)
 {
     try
     {
@@ -39,19 +49,67 @@ Midi::Midi(QObject *parent) :
     } catch ( RtMidiError &error ) {
         error.printMessage();
     }
-    scanMidiInterfaces();
+
+    // Enumerating ports is slow (ALSA sequencer queries): do it off the GUI thread
+    connect(&_portsScanner, SIGNAL(finished()), this, SLOT(portsScanned()));
+    scanMidiInterfacesAsync();
+
+    // Hot-plug: devices changes trigger a rescan (bursts of events are coalesced)
+    _rescanTimer.setSingleShot(true);
+    _rescanTimer.setInterval(MIDI_RESCAN_DELAY_MS);
+    connect(&_rescanTimer, SIGNAL(timeout()), this, SLOT(scanMidiInterfacesAsync()));
+    if(MidiDeviceWatcher::isSupported())
+    {
+        _deviceWatcher = new MidiDeviceWatcher(this);
+        connect(_deviceWatcher, SIGNAL(devicesChanged()), &_rescanTimer, SLOT(start()), Qt::QueuedConnection);
+        _deviceWatcher->start(QThread::LowPriority);
+    }
 }
 
 void Midi::scanMidiInterfaces()
+{
+    // Note: first interface may be a replay one (without any port), use a dedicated scanner
+    updateMidiInterfaces(listPorts());
+}
+
+void Midi::scanMidiInterfacesAsync()
+{
+    if(_portsScanner.isRunning())
+    {
+        // Scan again once current one is done: ports may have changed meanwhile
+        _rescanTimer.start();
+    }
+    else
+    {
+        _portsScanner.setFuture(QtConcurrent::run(&Midi::listPorts));
+    }
+}
+
+QStringList Midi::listPorts()
+{
+    QStringList ports;
+    try
+    {
+        RtMidiIn rtMidiIn(RtMidi::UNSPECIFIED, std::string("Minotor scanner"));
+        ports = getPorts(&rtMidiIn);
+    } catch ( RtMidiError &error ) {
+        error.printMessage();
+    }
+    return ports;
+}
+
+void Midi::portsScanned()
+{
+    updateMidiInterfaces(_portsScanner.result());
+}
+
+void Midi::updateMidiInterfaces(const QStringList &ports)
 {
     bool modified = false;
 
     QStringList midiInterfacePortNames;
     MidiInterfaces midiInterfaces = interfaces();
 
-    Q_ASSERT(midiInterfaces.count());
-    QStringList ports = midiInterfaces.at(0)->getPorts();
-
     foreach(MidiInterface *mi, midiInterfaces)
     {
         midiInterfacePortNames.append(mi->portName());
@@ -81,7 +139,7 @@ void Midi::scanMidiInterfaces()
     // In midiInterfaces, only remains not-available-anymore ports (candidate to deletion)
     foreach(MidiInterface *mi, midiInterfaces)
     {
-        if(!mi->isVirtual())
+        if(!mi->isVirtual() && !mi->isReplay())
         {
             if(mi->isConnected())
                 modified |= mi->close();
@@ -103,6 +161,9 @@ void Midi::scanMidiInterfaces()
 
 Midi::~Midi()
 {
+    if(_deviceWatcher)
+        _deviceWatcher->stop();
+    _portsScanner.waitForFinished();
 }
 
 QStringList Midi::getPorts(RtMidi *rtmidi)
@@ -120,9 +181,9 @@ QStringList Midi::getPorts(RtMidi *rtmidi)
     return ports;
 }
 
-MidiInterface* Midi::addMidiInterface(const QString &portName)
+MidiInterface* Midi::addMidiInterface(const QString &portName, const MidiInterface::Type type)
 {
-    MidiInterface * mi = new MidiInterface(portName, this);
+    MidiInterface * mi = new MidiInterface(portName, this, type);
     addMidiInterface(mi);
     return mi;
 }
@@ -146,7 +207,7 @@ void Midi::addMidiInterface(MidiInterface *interface)
     connect(interface, SIGNAL(continueReceived()), this, SIGNAL(continueReceived()));
     connect(interface, SIGNAL(controlChanged(int,quint8,quint8,quint8)), this, SIGNAL(controlChanged(int,quint8,quint8,quint8)));
     connect(interface, SIGNAL(programChanged(int,quint8,quint8)), this, SIGNAL(programChanged(int,quint8,quint8)));
-    connect(interface, SIGNAL(noteChanged(int,quint8,quint8,bool,quint8)), this, SIGNAL(noteChanged(int,quint8,quint8,bool,quint8)));
+    connect(interface, SIGNAL(noteChanged(int,quint8,quint8,bool,quint8,qint64)), this, SIGNAL(noteChanged(int,quint8,quint8,bool,quint8,qint64)));
 
 
     connect(interface, SIGNAL(startReceived()), this, SIGNAL(dataReceived()));
@@ -154,7 +215,7 @@ void Midi::addMidiInterface(MidiInterface *interface)
     connect(interface, SIGNAL(continueReceived()), this, SIGNAL(dataReceived()));
     connect(interface, SIGNAL(controlChanged(int,quint8,quint8,quint8)), this, SIGNAL(dataReceived()));
     connect(interface, SIGNAL(programChanged(int,quint8,quint8)), this, SIGNAL(dataReceived()));
-    connect(interface, SIGNAL(noteChanged(int,quint8,quint8,bool,quint8)), this, SIGNAL(dataReceived()));
+    connect(interface, SIGNAL(noteChanged(int,quint8,quint8,bool,quint8,qint64)), this, SIGNAL(dataReceived()));
 }
 
 MidiInterface *Midi::findMidiInterface(const int id)
@@ -23,10 +23,14 @@
 
 #include <QObject>
 #include <QStringList>
+#include <QFutureWatcher>
+#include <QTimer>
 
 #include "RtMidi.h"
 
-class MidiInterface;
+#include "midiinterface.h"
+
+class MidiDeviceWatcher;
 typedef QList<MidiInterface*> MidiInterfaces;
 
 class Midi : public QObject
@@ -41,18 +45,28 @@ public:
     // Interfaces
     MidiInterfaces interfaces();
     MidiInterface* interface(const QString& portName);
-    MidiInterface* addMidiInterface(const QString& portName);
+    MidiInterface* addMidiInterface(const QString& portName, const MidiInterface::Type type = MidiInterface::Normal);
     MidiInterface* findMidiInterface(const int id);
 
 public slots:
     // Scan interfaces
     void scanMidiInterfaces();
+    // Same as scanMidiInterfaces(), ports are enumerated on a worker thread
+    void scanMidiInterfacesAsync();
+
+private slots:
+    void portsScanned();
 
 private:
     int grabMidiInterfaceId();
     void addMidiInterface(MidiInterface *interface);
+    void updateMidiInterfaces(const QStringList &ports);
+    static QStringList listPorts();
 
     MidiInterfaces _interfaces;
+    QFutureWatcher<QStringList> _portsScanner;
+    QTimer _rescanTimer;
+    MidiDeviceWatcher *_deviceWatcher;
 
 signals:
     // Transport
@@ -68,7 +82,7 @@ signals:
     void programChanged(int interface, quint8 channel, quint8 program);
 
     // Note
-    void noteChanged(int interface, quint8 channel, quint8 note, bool on, quint8 value);
+    void noteChanged(int interface, quint8 channel, quint8 note, bool on, quint8 value, qint64 timestamp);
 
     // CC, Note and program changes emit this signal
     void dataReceived();
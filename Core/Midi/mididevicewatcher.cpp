@@ -0,0 +1,117 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "mididevicewatcher.h"
+
+#include <QDebug>
+
+#if defined(__LINUX_ALSA__)
+#include <alsa/asoundlib.h>
+#include <poll.h>
+#endif
+
+// Watcher wakes up at this rate (at most) to check if it has been asked to stop
+#define MIDIDEVICEWATCHER_STOP_CHECK_MS 250
+
+MidiDeviceWatcher::MidiDeviceWatcher(QObject *parent) :
+    QThread(parent),
+    _stopRequested(false)
+{
+}
+
+MidiDeviceWatcher::~MidiDeviceWatcher()
+{
+    stop();
+}
+
+bool MidiDeviceWatcher::isSupported()
+{
+#if defined(__LINUX_ALSA__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MidiDeviceWatcher::stop()
+{
+    _stopRequested = true;
+    wait();
+}
+
+void MidiDeviceWatcher::run()
+{
+#if defined(__LINUX_ALSA__)
+    snd_seq_t *seq = NULL;
+    if(snd_seq_open(&seq, "default", SND_SEQ_OPEN_INPUT, SND_SEQ_NONBLOCK) < 0)
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to open ALSA sequencer";
+        return;
+    }
+    snd_seq_set_client_name(seq, "Minotor device watcher");
+
+    const int port = snd_seq_create_simple_port(seq, "announce",
+                                                SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE | SND_SEQ_PORT_CAP_NO_EXPORT,
+                                                SND_SEQ_PORT_TYPE_APPLICATION);
+    if((port < 0) || (snd_seq_connect_from(seq, port, SND_SEQ_CLIENT_SYSTEM, SND_SEQ_PORT_SYSTEM_ANNOUNCE) < 0))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to subscribe to ALSA announce port";
+        snd_seq_close(seq);
+        return;
+    }
+
+    const int fdCount = snd_seq_poll_descriptors_count(seq, POLLIN);
+    struct pollfd *fds = new struct pollfd[fdCount];
+    snd_seq_poll_descriptors(seq, fds, fdCount, POLLIN);
+
+    while(!_stopRequested)
+    {
+        if(poll(fds, fdCount, MIDIDEVICEWATCHER_STOP_CHECK_MS) <= 0)
+            continue;
+
+        bool changed = false;
+        snd_seq_event_t *event = NULL;
+        while(snd_seq_event_input(seq, &event) >= 0)
+        {
+            // Only ports are watched: clients come and go without ports (ie. RtMidi instances
+            // used to enumerate ports) and would trigger useless rescans
+            switch(event->type)
+            {
+            case SND_SEQ_EVENT_PORT_START:
+            case SND_SEQ_EVENT_PORT_EXIT:
+                changed = true;
+                break;
+            default:
+                break;
+            }
+        }
+        if(changed)
+        {
+            emit devicesChanged();
+        }
+    }
+
+    delete[] fds;
+    snd_seq_close(seq);
+#endif
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDIDEVICEWATCHER_H
+#define MIDIDEVICEWATCHER_H
+
+#include <QThread>
+
+// Background thread notifying MIDI devices plug/unplug
+// On Linux, it listens to ALSA sequencer announce port (no polling of ports list).
+// On other platforms, it does nothing: ports are only scanned on demand.
+class MidiDeviceWatcher : public QThread
+{
+    Q_OBJECT
+public:
+    explicit MidiDeviceWatcher(QObject *parent = 0);
+    ~MidiDeviceWatcher();
+
+    // Returns false when hot-plug notifications are not available on this platform
+    static bool isSupported();
+
+    void stop();
+
+signals:
+    // Emitted (from watcher thread) when a client or a port appeared or disappeared
+    void devicesChanged();
+
+protected:
+    void run();
+
+private:
+    // Only written by stop(): thread can't miss a stop request issued before it entered its loop
+    volatile bool _stopRequested;
+};
+
+#endif // MIDIDEVICEWATCHER_H
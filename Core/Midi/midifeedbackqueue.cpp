@@ -0,0 +1,103 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midifeedbackqueue.h"
+
+#include <QMutexLocker>
+
+#include "midiinterface.h"
+
+// Default pace: a third of MIDI DIN bandwidth (~1000 messages/s), USB controllers are often slower
+#define MIDIFEEDBACKQUEUE_DEFAULT_RATE 300
+
+MidiFeedbackQueue::MidiFeedbackQueue(MidiInterface *interface) :
+    QThread(interface),
+    _interface(interface),
+    _rate(MIDIFEEDBACKQUEUE_DEFAULT_RATE),
+    _running(false)
+{
+}
+
+MidiFeedbackQueue::~MidiFeedbackQueue()
+{
+    stop();
+}
+
+void MidiFeedbackQueue::setRate(const int rate)
+{
+    if(rate > 0)
+        _rate = rate;
+}
+
+void MidiFeedbackQueue::postControlChange(const quint8 channel, const quint8 control, const quint8 value)
+{
+    QMutexLocker locker(&_mutex);
+    const quint16 key = (channel << 8) | control;
+    if(!_pendingValues.contains(key))
+        _pendingOrder.append(key);
+    _pendingValues.insert(key, value);
+
+    if(!_running)
+    {
+        _running = true;
+        start(QThread::LowPriority);
+    }
+    _pendingCondition.wakeOne();
+}
+
+void MidiFeedbackQueue::clear()
+{
+    QMutexLocker locker(&_mutex);
+    _pendingValues.clear();
+    _pendingOrder.clear();
+}
+
+void MidiFeedbackQueue::stop()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _running = false;
+        _pendingCondition.wakeOne();
+    }
+    wait();
+}
+
+void MidiFeedbackQueue::run()
+{
+    forever
+    {
+        quint16 key;
+        quint8 value;
+        {
+            QMutexLocker locker(&_mutex);
+            while(_running && _pendingOrder.isEmpty())
+                _pendingCondition.wait(&_mutex);
+            if(!_running)
+                break;
+            key = _pendingOrder.takeFirst();
+            value = _pendingValues.take(key);
+        }
+        _interface->sendControlChange(key >> 8, key & 0xff, value);
+
+        // Pace output to device's capacity
+        usleep(1000000 / _rate);
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDIFEEDBACKQUEUE_H
+#define MIDIFEEDBACKQUEUE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QList>
+
+class MidiInterface;
+
+// Per-interface output queue for feedback messages (LEDs, motorized controls...)
+//  - runs on its own thread: senders never block on device I/O,
+//  - coalesces messages: only last value of a given channel/control is sent,
+//  - sends at most rate() messages per second (controllers drop messages when flooded).
+class MidiFeedbackQueue : public QThread
+{
+    Q_OBJECT
+public:
+    explicit MidiFeedbackQueue(MidiInterface *interface);
+    ~MidiFeedbackQueue();
+
+    // Queue a 'Control Change' (thread-safe)
+    void postControlChange(const quint8 channel, const quint8 control, const quint8 value);
+
+    // Maximum messages sent per second
+    int rate() const { return _rate; }
+    void setRate(const int rate);
+
+    // Drop pending messages (ie. when interface is closed)
+    void clear();
+
+    void stop();
+
+protected:
+    void run();
+
+private:
+    MidiInterface *_interface;
+    int _rate;
+
+    QMutex _mutex;
+    QWaitCondition _pendingCondition;
+    bool _running;
+    // Channel/control -> last value, plus first-queued order
+    QHash<quint16, quint8> _pendingValues;
+    QList<quint16> _pendingOrder;
+};
+
+#endif // MIDIFEEDBACKQUEUE_H
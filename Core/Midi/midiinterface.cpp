@@ -26,8 +26,12 @@
 #include "midi.h"
 #include "midimapping.h"
 #include "midimapper.h"
+#include "midifeedbackqueue.h"
+#include "midirecorder.h"
 
 #include "minotor.h"
+#include "minoprofiler.h"
+#include "minotracerecorder.h"
 
 #include <QRegExp>
 
@@ -36,6 +40,7 @@ MidiInterface::MidiInterface(const QString& portName, Midi *parent, MidiInterfac
     _midi(parent),
     _rtMidiIn(NULL),
     _rtMidiOut(NULL),
+    _feedback(NULL),
     _id(-1),
     _portIndex(0),
     _connected(false),
@@ -49,6 +54,9 @@ MidiInterface::MidiInterface(const QString& portName, Midi *parent, MidiInterfac
     setObjectName(portName);
 
     _isVirtual = (type == MidiInterface::Virtual);
+    _isReplay = (type == MidiInterface::Replay);
+    if(_isReplay)
+        return;
 
     try
     {
@@ -59,6 +67,7 @@ MidiInterface::MidiInterface(const QString& portName, Midi *parent, MidiInterfac
         {
             // If interface is not virtual, you will try to find an output
             _rtMidiOut = new RtMidiOut();
+            _feedback = new MidiFeedbackQueue(this);
         }
     } catch ( RtMidiError &error ) {
         error.printMessage();
@@ -67,6 +76,9 @@ MidiInterface::MidiInterface(const QString& portName, Midi *parent, MidiInterfac
 
 MidiInterface::~MidiInterface()
 {
+    // Feedback thread uses output port
+    if(_feedback)
+        _feedback->stop();
     if(_rtMidiIn)
         delete _rtMidiIn;
     if(_rtMidiOut)
@@ -114,6 +126,27 @@ MidiInterface::~MidiInterface()
 void MidiInterface::midiCallback(double deltatime, std::vector< unsigned char > *message)
 {
     (void)deltatime;
+    // RtMidi deltatime is relative to previous message: use our monotonic clock to share timebase with frames
+    receive(message, MinoProfiler::now());
+}
+
+void MidiInterface::receive(std::vector< unsigned char > *message, const qint64 timestamp)
+{
+    MinoTraceRecorder *recorder = MinoTraceRecorder::recorder();
+    if(recorder->isRecording())
+    {
+        // Value is first bytes of the message (status, data1, data2)
+        static const int midiKey = MinoProfiler::profiler()->key("midi");
+        int value = 0;
+        for(unsigned int i=0; i<qMin((size_t)3, message->size()); i++)
+            value = (value << 8) | message->at(i);
+        recorder->instant(midiKey, timestamp, value);
+    }
+
+    MidiRecorder *midiRecorder = MidiRecorder::recorder();
+    if(midiRecorder->isRecording())
+        midiRecorder->record(this, timestamp, message->data(), message->size());
+
     unsigned char command = message->at(0);
     quint8 channel = command & 0x0f;
     if ((command&0xf0) != 0xf0) // if it is NOT a System message
@@ -124,11 +157,11 @@ void MidiInterface::midiCallback(double deltatime, std::vector< unsigned char >
     switch(command) {
     case MIDI_CVM_NOTE_OFF:
         if(_acceptNoteChange)
-            emit noteChanged(_id, quint8 (channel), quint8 (message->at(1)), false, quint8(message->at(2)));
+            emit noteChanged(_id, quint8 (channel), quint8 (message->at(1)), false, quint8(message->at(2)), timestamp);
         break;
     case MIDI_CVM_NOTE_ON:
         if(_acceptNoteChange)
-            emit noteChanged(_id, quint8 (channel), quint8 (message->at(1)), true, quint8(message->at(2)));
+            emit noteChanged(_id, quint8 (channel), quint8 (message->at(1)), true, quint8(message->at(2)), timestamp);
         break;
     case MIDI_CVM_CONTROL_CHANGE:
         if(_acceptControlChange)
@@ -243,6 +276,18 @@ void _midiCallback(double deltatime, std::vector< unsigned char > *message, void
 
 bool MidiInterface::open()
 {
+    if(_isReplay)
+    {
+        if(!_connected)
+        {
+            if(_id == -1)
+                setId(_midi->grabMidiInterfaceId());
+            _connected = true;
+            emit(connected());
+            loadMapping();
+        }
+        return true;
+    }
     if(_isVirtual)
     {
         if(_hasVirtualSupport)
@@ -378,8 +423,11 @@ bool MidiInterface::openOut(const unsigned int portIndex)
         {
             _portIndex = portIndex;
             try {
-                _rtMidiOut->openPort(portIndex);
-                _hasOutput = true;
+                {
+                    QMutexLocker locker(&_outputMutex);
+                    _rtMidiOut->openPort(portIndex);
+                    _hasOutput = true;
+                }
                 qDebug() << "MIDI Out connected to: " << this->portName();
 
                 // Ask device to give its identity
@@ -409,34 +457,58 @@ void MidiInterface::sendIdentityRequest()
 
 bool MidiInterface::sendControlChange(const int channel, const int control, const int value)
 {
+    QMutexLocker locker(&_outputMutex);
     if (_hasOutput)
     {
-        std::vector< unsigned char > message;
-        message.push_back(MIDI_CVM_CONTROL_CHANGE | (channel&0x0f));
-        message.push_back(control);
-        message.push_back(value);
+        std::vector< unsigned char > message(3);
+        message[0] = MIDI_CVM_CONTROL_CHANGE | (channel&0x0f);
+        message[1] = control;
+        message[2] = value;
         _rtMidiOut->sendMessage(&message);
     }
     return true;
 }
 
+void MidiInterface::queueControlChange(const quint8 channel, const quint8 control, const quint8 value)
+{
+    if(_feedback && _hasOutput)
+    {
+        _feedback->postControlChange(channel, control, value);
+    }
+}
+
+int MidiInterface::feedbackRate() const
+{
+    return _feedback ? _feedback->rate() : 0;
+}
+
+void MidiInterface::setFeedbackRate(const int rate)
+{
+    if(_feedback)
+    {
+        _feedback->setRate(rate);
+    }
+}
+
 bool MidiInterface::sendMessage(const QByteArray &bytes)
 {
+    QMutexLocker locker(&_outputMutex);
     if (_hasOutput)
     {
-        std::vector< unsigned char > message;
-        for(int i=0; i<bytes.count(); ++i)
-        {
-            message.push_back(bytes[i]);
-        }
+        std::vector< unsigned char > message(bytes.constData(), bytes.constData() + bytes.count());
         _rtMidiOut->sendMessage(&message);
-        qDebug() << Q_FUNC_INFO << "data:" << bytes.toHex();
     }
     return true;
 }
 
 bool MidiInterface::close()
 {
+    if(_isReplay && _connected)
+    {
+        _connected = false;
+        emit(connected(false));
+        flushMapping();
+    }
     if(_rtMidiIn && _connected)
     {
         _rtMidiIn->closePort();
@@ -444,6 +516,9 @@ bool MidiInterface::close()
         _connected = false;
         if(_rtMidiOut && _hasOutput)
         {
+            if(_feedback)
+                _feedback->clear();
+            QMutexLocker locker(&_outputMutex);
             _rtMidiOut->closePort();
             _hasOutput = false;
         }
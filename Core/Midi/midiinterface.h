@@ -23,10 +23,12 @@
 
 #include <QObject>
 #include <QSettings>
+#include <QMutex>
 
 #include "RtMidi.h"
 
 class Midi;
+class MidiFeedbackQueue;
 
 class MidiInterface : public QObject
 {
@@ -34,8 +36,10 @@ class MidiInterface : public QObject
 
     Q_PROPERTY(QString name READ portName)
     Q_PROPERTY(QString mapping READ mapping WRITE setMapping)
+    Q_PROPERTY(int feedbackRate READ feedbackRate WRITE setFeedbackRate)
 public:
-    enum Type { Normal, Virtual };
+    // Replay: no device behind, messages are fed by MidiReplayer
+    enum Type { Normal, Virtual, Replay };
     explicit MidiInterface(const QString &portName, Midi *parent, MidiInterface::Type type = MidiInterface::Normal);
     ~MidiInterface();
 
@@ -51,6 +55,7 @@ public:
     // Test if MIDI interface is virtual
     bool isVirtual() const { return _isVirtual; }
     bool hasVirtualSupport() const { return _hasVirtualSupport; }
+    bool isReplay() const { return _isReplay; }
 
     // Retrieve current connected port name
     QString portName() const;
@@ -76,17 +81,29 @@ public:
     void loadMapping();
     void flushMapping();
 
-    // Send 'Control Change' to device
+    // Send 'Control Change' to device (thread-safe)
     bool sendControlChange(const int channel, const int control, const int value);
+    // Queue a feedback 'Control Change': sent asynchronously, coalesced and rate limited
+    void queueControlChange(const quint8 channel, const quint8 control, const quint8 value);
+
+    // Maximum feedback messages per second the device can handle
+    int feedbackRate() const;
+    void setFeedbackRate(const int rate);
 
     // RtMidi callback
     // Warning: Should not be used by user...
     void midiCallback( double deltatime, std::vector< unsigned char > *message);
+    // Handle a received message, timestamp is in MinoProfiler::now() timebase
+    // (or any timebase shared with clock pulses, ie. offline rendering)
+    void receive(std::vector< unsigned char > *message, const qint64 timestamp);
 
 private:
     Midi *_midi;
     RtMidiIn *_rtMidiIn;
     RtMidiOut *_rtMidiOut;
+    // Protects _rtMidiOut: feedback messages are sent from their own thread
+    QMutex _outputMutex;
+    MidiFeedbackQueue *_feedback;
     int _id;
     unsigned int _portIndex;
     QString _portName;
@@ -97,6 +114,7 @@ private:
     QString _mapping;
 
     bool _isVirtual;
+    bool _isReplay;
 
     bool _acceptClock;
     bool _acceptProgramChange;
@@ -132,7 +150,8 @@ signals:
     void continueReceived();
     void controlChanged(int interface, quint8 channel, quint8 control, quint8 value);
     void programChanged(int interface, quint8 channel, quint8 program);
-    void noteChanged(int interface, quint8 channel, quint8 note, bool on, quint8 value);
+    // timestamp: MinoProfiler::now() when message arrived (before any queued delivery)
+    void noteChanged(int interface, quint8 channel, quint8 note, bool on, quint8 value, qint64 timestamp);
     void acceptClockChanged(bool clock);
     void acceptControlChanged(bool control);
     void acceptProgramChanged(bool program);
@@ -31,7 +31,7 @@ MidiMapper::MidiMapper(Minotor *minotor) :
 {
     // Link Minotor to MidiMapper
     connect(minotor->midi(), SIGNAL(controlChanged(int,quint8,quint8,quint8)), this, SLOT(midiControlChanged(int,quint8,quint8,quint8)));
-    connect(minotor->midi(), SIGNAL(noteChanged(int,quint8,quint8,bool,quint8)), this, SLOT(noteChanged(int,quint8,quint8,bool,quint8)));
+    connect(minotor->midi(), SIGNAL(noteChanged(int,quint8,quint8,bool,quint8,qint64)), this, SLOT(noteChanged(int,quint8,quint8,bool,quint8)));
 }
 
 MidiMapper::~MidiMapper()
@@ -101,8 +101,6 @@ MidiControl* MidiMapper::findMidiControl(const int interface, const quint8 chann
 
 void MidiMapper::midiControlChanged(int interface, quint8 channel, quint8 control, quint8 value)
 {
-    qDebug() << Q_FUNC_INFO
-             << "control changed:" << interface << channel << control << value;
     MidiControl *midiControl = findMidiControl(interface, channel, control, _controlCaptureMode);
     if(midiControl)
     {
@@ -120,44 +118,30 @@ void MidiMapper::midiControlChanged(int interface, quint8 channel, quint8 contro
     if(minoTrigger)
     {
         minoTrigger->setStatus(value==127);
-        qDebug() << Q_FUNC_INFO
-                 << "trigger found:" << minoTrigger << minoTrigger->role();
     }
     else
     {
-        qDebug() << Q_FUNC_INFO
-                 << "no associated trigger found.";
         MinoControl *minoControl = findMinoControl(interface, channel, control);
         if(minoControl)
         {
             minoControl->setValue(value);
-            qDebug() << Q_FUNC_INFO
-                     << "control found:" << minoControl << minoControl->role();
-        }
-        else
-        {
-            qDebug() << Q_FUNC_INFO
-                     << "no associated control found.";
         }
     }
 }
 
 MinoTrigger* MidiMapper::findMinoTriggerFromNote(const int interface, const quint8 channel, const quint8 note) const
 {
-    const QString key = QString("%1:%2:%3").arg(QString::number(interface)).arg(QString::number(channel)).arg(QString::number(note));
-    return _hashMinoTriggerNotes.value(key, NULL);
+    return _hashMinoTriggerNotes.value(routingKey(interface, channel, note), NULL);
 }
 
 MinoTrigger* MidiMapper::findMinoTriggerFromControl(const int interface, const quint8 channel, const quint8 control) const
 {
-    const QString key = QString("%1:%2:%3").arg(QString::number(interface)).arg(QString::number(channel)).arg(QString::number(control));
-    return _hashMinoTriggerControls.value(key, NULL);
+    return _hashMinoTriggerControls.value(routingKey(interface, channel, control), NULL);
 }
 
 MinoControl* MidiMapper::findMinoControl(const int interface, const quint8 channel, const quint8 control) const
 {
-    const QString key = QString("%1:%2:%3").arg(QString::number(interface)).arg(QString::number(channel)).arg(QString::number(control));
-    return _hashMinoControls.value(key, NULL);
+    return _hashMinoControls.value(routingKey(interface, channel, control), NULL);
 }
 
 void MidiMapper::noteChanged(int interface, quint8 channel, quint8 note, bool on, quint8 value)
@@ -168,23 +152,12 @@ void MidiMapper::noteChanged(int interface, quint8 channel, quint8 note, bool on
         // Some MIDI controllers (eg. BCD3000) do not send 'note off' but 'note on' with no velocity (value==0)
         if(value==0) on = false;
         minoTrigger->setStatus(on);
-        qDebug() << Q_FUNC_INFO
-                 << "trigger found:" << minoTrigger->role()
-                 << "(" << on << ")";
-    }
-    else
-    {
-        /*
-        qDebug() << Q_FUNC_INFO
-                 << "no associated trigger found for note:" << note
-                 << QString("(%1,%2,%3)").arg(QString::number(interface)).arg(QString::number(channel)).arg(QString::number(note));
-                 */
     }
 }
 
 void MidiMapper::mapNoteToRole(const int interface, const quint8 channel, const quint8 note, const QString &role)
 {
-    const QString key = QString("%1:%2:%3").arg(QString::number(interface)).arg(QString::number(channel)).arg(QString::number(note));
+    const quint32 key = routingKey(interface, channel, note);
     MinoRole *mr = minoRoles().value(role, NULL);
     Q_ASSERT(mr);
 
@@ -195,7 +168,7 @@ void MidiMapper::mapNoteToRole(const int interface, const quint8 channel, const
 
 void MidiMapper::mapControlToRole(const int interface, const quint8 channel, const quint8 control, const QString &role)
 {
-    const QString key = QString("%1:%2:%3").arg(QString::number(interface)).arg(QString::number(channel)).arg(QString::number(control));
+    const quint32 key = routingKey(interface, channel, control);
     MinoRole *mr = minoRoles().value(role, NULL);
     Q_ASSERT(mr);
 
@@ -212,11 +185,13 @@ void MidiMapper::mapControlToRole(const int interface, const quint8 channel, con
     {
         MinoTrigger *mt = minoTriggers().value(role, NULL);
         Q_ASSERT(mt);
-        qDebug() << Q_FUNC_INFO
-                  << mt->role() << mt << " feedback(bool) is connected to triggerFeedback(bool)";
         connect(mt, SIGNAL(feedback(bool)), this, SLOT(triggerFeedback(bool)), Qt::UniqueConnection);
 
+        // Control may have been mapped to another trigger before
+        if(MinoTrigger *previous = _hashMinoTriggerControls.value(key, NULL))
+            _hashFeedbackControls.remove(previous, key);
         _hashMinoTriggerControls.insert(key, mt);
+        _hashFeedbackControls.insert(mt, key);
 
         // This HACK allow MidiMapper to receive last feedback (again) in order to propagate feedback status to newly mapped control
         mt->forceFeedbackEmitting();
@@ -231,17 +206,17 @@ void MidiMapper::triggerFeedback(bool on)
     // FIXME this function is not generic and have been written with only nanoKontrol 2 LEDs usage in mind.
     MinoTrigger *mt = qobject_cast<MinoTrigger*>(sender());
     Q_ASSERT(mt);
-    QStringList keys = _hashMinoTriggerControls.keys(mt);
-    foreach(QString key, keys)
+    Midi *midi = Minotor::minotor()->midi();
+    QMultiHash<MinoTrigger*, quint32>::const_iterator it = _hashFeedbackControls.constFind(mt);
+    while((it != _hashFeedbackControls.constEnd()) && (it.key() == mt))
     {
-        QStringList sl = key.split(':');
-        Q_ASSERT(sl.count() == 3);
-        const int id = sl.at(0).toInt();
-        const int channel = sl.at(1).toInt();
-        const int control = sl.at(2).toInt();
-        MidiInterface *mi = Minotor::minotor()->midi()->findMidiInterface(id);
+        const quint32 key = it.value();
+        MidiInterface *mi = midi->findMidiInterface(routingKeyInterface(key));
         // HACK to drive LEDs on nanoKontrol 2 (when LED mode have been setup as external using Korg software)
-        mi->sendControlChange(channel, control, on?127:0);
+        // Messages are queued: bursts (ie. on bank switch) are coalesced and sent at device's pace
+        if(mi)
+            mi->queueControlChange(routingKeyChannel(key), routingKeyControl(key), on?127:0);
+        ++it;
     }
 }
 
@@ -373,14 +348,19 @@ QList<MinoRole *> MidiMapper::registeredRoles()
     return roles;
 }
 
+QString MidiMapper::routingKeyToString(const quint32 key)
+{
+    return QString("%1:%2:%3").arg(routingKeyInterface(key)).arg(routingKeyChannel(key)).arg(routingKeyControl(key));
+}
+
 QString MidiMapper::findMinoControlFromRole(const QString &role) const
 {
-    QHash<QString, MinoControl*>::const_iterator i = _hashMinoControls.constBegin();
+    QHash<quint32, MinoControl*>::const_iterator i = _hashMinoControls.constBegin();
     while (i != _hashMinoControls.constEnd()) {
         MinoControl *mc = i.value();
         if(mc->role() == role)
         {
-            return i.key();
+            return routingKeyToString(i.key());
         }
         ++i;
     }
@@ -389,12 +369,12 @@ QString MidiMapper::findMinoControlFromRole(const QString &role) const
 
 QString MidiMapper::findMinoTriggerControlFromRole(const QString &role) const
 {
-    QHash<QString, MinoTrigger*>::const_iterator i = _hashMinoTriggerControls.constBegin();
+    QHash<quint32, MinoTrigger*>::const_iterator i = _hashMinoTriggerControls.constBegin();
     while (i != _hashMinoTriggerControls.constEnd()) {
         MinoTrigger *mt = i.value();
         if(mt->role() == role)
         {
-            return i.key();
+            return routingKeyToString(i.key());
         }
         ++i;
     }
@@ -404,89 +384,39 @@ QString MidiMapper::findMinoTriggerControlFromRole(const QString &role) const
 void MidiMapper::flushMidiMapping(MidiInterface *mi)
 {
     int deletedControlCount = 0;
+
     // Trigger controls
-    QHash<QString, MinoTrigger*>::const_iterator itc = _hashMinoTriggerControls.constBegin();
-    QStringList toBeDeleted;
-    while (itc != _hashMinoTriggerControls.constEnd()) {
-        QRegExp rx("(\\d+):(\\d+):(\\d+)");
-        if(rx.indexIn(itc.key()) == -1)
+    QMutableHashIterator<quint32, MinoTrigger*> itc(_hashMinoTriggerControls);
+    while (itc.hasNext()) {
+        itc.next();
+        if(routingKeyInterface(itc.key()) == mi->id())
         {
-            qDebug() << Q_FUNC_INFO
-                     << "no match for control:" << itc.key();
-            Q_ASSERT(false);
-        }
-        else
-        {
-            QStringList sl = rx.capturedTexts();
-            Q_ASSERT(sl.count()==4);
-            if(sl.at(1).toInt() == mi->id())
-            {
-                toBeDeleted.append(itc.key());
-                ++deletedControlCount;
-            }
+            _hashFeedbackControls.remove(itc.value(), itc.key());
+            itc.remove();
+            ++deletedControlCount;
         }
-        ++itc;
-    }
-
-    foreach(const QString& tbd, toBeDeleted)
-    {
-        _hashMinoTriggerControls.remove(tbd);
     }
 
     // Trigger note
-    QHash<QString, MinoTrigger*>::const_iterator itn = _hashMinoTriggerNotes.constBegin();
-    while (itn != _hashMinoTriggerNotes.constEnd()) {
-        QRegExp rx("(\\d+):(\\d+):(\\d+)");
-        if(rx.indexIn(itn.key()) == -1)
-        {
-            qDebug() << Q_FUNC_INFO
-                     << "no match for control:" << itn.key();
-            Q_ASSERT(false);
-        }
-        else
+    QMutableHashIterator<quint32, MinoTrigger*> itn(_hashMinoTriggerNotes);
+    while (itn.hasNext()) {
+        itn.next();
+        if(routingKeyInterface(itn.key()) == mi->id())
         {
-            QStringList sl = rx.capturedTexts();
-            Q_ASSERT(sl.count()==4);
-            if(sl.at(1).toInt() == mi->id())
-            {
-                toBeDeleted.append(itn.key());
-                ++deletedControlCount;
-            }
+            itn.remove();
+            ++deletedControlCount;
         }
-        ++itn;
-    }
-
-    foreach(const QString& tbd, toBeDeleted)
-    {
-        _hashMinoTriggerNotes.remove(tbd);
     }
 
     // Control Change (direct)
-    QHash<QString, MinoControl*>::const_iterator icc = _hashMinoControls.constBegin();
-    while (icc != _hashMinoControls.constEnd()) {
-        QRegExp rx("(\\d+):(\\d+):(\\d+)");
-        if(rx.indexIn(icc.key()) == -1)
-        {
-            qDebug() << Q_FUNC_INFO
-                     << "no match for control:" << icc.key();
-            Q_ASSERT(false);
-        }
-        else
+    QMutableHashIterator<quint32, MinoControl*> icc(_hashMinoControls);
+    while (icc.hasNext()) {
+        icc.next();
+        if(routingKeyInterface(icc.key()) == mi->id())
         {
-            QStringList sl = rx.capturedTexts();
-            Q_ASSERT(sl.count()==4);
-            if(sl.at(1).toInt() == mi->id())
-            {
-                toBeDeleted.append(icc.key());
-                ++deletedControlCount;
-            }
+            icc.remove();
+            ++deletedControlCount;
         }
-        ++icc;
-    }
-
-    foreach(const QString& tbd, toBeDeleted)
-    {
-        _hashMinoControls.remove(tbd);
     }
 
     if(deletedControlCount)
@@ -110,14 +110,27 @@ protected:
     MidiControllableParameter * _currentControlCaptureParameter;
     MidiControlList _midiControls;
 
+    // Numeric routing key: interface (16 bits), channel (8 bits), control or note (8 bits)
+    static quint32 routingKey(const int interface, const quint8 channel, const quint8 control)
+    {
+        return ((quint32)(interface & 0xffff) << 16) | ((quint32)channel << 8) | control;
+    }
+    static int routingKeyInterface(const quint32 key) { return key >> 16; }
+    static quint8 routingKeyChannel(const quint32 key) { return (key >> 8) & 0xff; }
+    static quint8 routingKeyControl(const quint32 key) { return key & 0xff; }
+    static QString routingKeyToString(const quint32 key);
+
     // Notes -> MinoTrigger* association
-    QHash<QString, MinoTrigger*> _hashMinoTriggerNotes;
+    QHash<quint32, MinoTrigger*> _hashMinoTriggerNotes;
 
     // Controls -> MinoTrigger* association
-    QHash<QString, MinoTrigger*> _hashMinoTriggerControls;
+    QHash<quint32, MinoTrigger*> _hashMinoTriggerControls;
+
+    // MinoTrigger* -> Controls association (feedback routing)
+    QMultiHash<MinoTrigger*, quint32> _hashFeedbackControls;
 
     // Controls -> MinoControl* association
-    QHash<QString, MinoControl*> _hashMinoControls;
+    QHash<quint32, MinoControl*> _hashMinoControls;
 
     // Registered roles
     QHash<QString, MinoRole*> _hashMinoRoles;
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midirecorder.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "midiinterface.h"
+
+// Records are buffered, then written by chunks
+#define MIDIRECORDER_FLUSH_SIZE 65536
+
+MidiRecorder::MidiRecorder() :
+    _recording(false),
+    _lastTime(0),
+    _messageCount(0)
+{
+}
+
+bool MidiRecorder::start(const QString &fileName)
+{
+    stop();
+
+    QMutexLocker locker(&_mutex);
+    _file.setFileName(fileName);
+    if(!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to open" << fileName;
+        return false;
+    }
+    _buffer.clear();
+    _buffer.append(magic(), 4);
+    _buffer.append((char)version);
+    _interfaces.clear();
+    _lastTime = -1;
+    _messageCount = 0;
+    _recording = true;
+    return true;
+}
+
+void MidiRecorder::stop()
+{
+    QMutexLocker locker(&_mutex);
+    if(!_recording)
+        return;
+    _recording = false;
+    flush();
+    _file.close();
+}
+
+void MidiRecorder::record(const MidiInterface *interface, const qint64 timestamp, const unsigned char *bytes, const int size)
+{
+    // SysEx dumps are not needed to replay a show
+    if((size <= 0) || (size > 255))
+        return;
+
+    QMutexLocker locker(&_mutex);
+    if(!_recording)
+        return;
+
+    // First message gives the time origin
+    const qint64 time = timestamp / 1000;
+    if(_lastTime < 0)
+        _lastTime = time;
+    const quint64 delta = qMax((qint64)0, time - _lastTime);
+    _lastTime += delta;
+
+    if(!_interfaces.contains(interface))
+    {
+        if(_interfaces.count() > 255)
+            return;
+        const quint8 index = _interfaces.count();
+        _interfaces.insert(interface, index);
+        appendVarint(0);
+        _buffer.append((char)index);
+        _buffer.append((char)0);
+        appendString(interface->portName());
+        appendString(interface->mapping());
+    }
+
+    appendVarint(delta);
+    _buffer.append((char)_interfaces.value(interface));
+    _buffer.append((char)size);
+    _buffer.append(reinterpret_cast<const char*>(bytes), size);
+    _messageCount++;
+
+    if(_buffer.size() >= MIDIRECORDER_FLUSH_SIZE)
+        flush();
+}
+
+void MidiRecorder::appendVarint(quint64 value)
+{
+    while(value >= 0x80)
+    {
+        _buffer.append((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    _buffer.append((char)value);
+}
+
+void MidiRecorder::appendString(const QString &string)
+{
+    const QByteArray utf8 = string.toUtf8().left(255);
+    _buffer.append((char)utf8.size());
+    _buffer.append(utf8);
+}
+
+void MidiRecorder::flush()
+{
+    if(_file.write(_buffer) != _buffer.size())
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "write error" << _file.fileName();
+    }
+    _buffer.clear();
+}
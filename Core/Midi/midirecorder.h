@@ -0,0 +1,75 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDIRECORDER_H
+#define MIDIRECORDER_H
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+class MidiInterface;
+
+// Records MIDI messages received by every interface (as seen by MidiInterface::midiCallback)
+// into a compact binary log, to be played back by MidiReplayer.
+//
+// File format: "MMRC" magic, version byte, then records:
+//   delta time since previous record (microseconds, LEB128 varint)
+//   interface index (byte)
+//   message size (byte) and message bytes
+// A record with a null size declares an interface (first time it is seen):
+//   port name and mapping file name (each one as size byte + UTF-8 bytes)
+class MidiRecorder
+{
+public:
+    // Singleton accessor
+    static MidiRecorder *recorder() { static MidiRecorder *recorder = new MidiRecorder(); return recorder; }
+
+    bool start(const QString &fileName);
+    void stop();
+    bool isRecording() const { return _recording; }
+
+    // Thread-safe (called from MIDI callbacks). timestamp is MinoProfiler::now() ns
+    void record(const MidiInterface *interface, const qint64 timestamp, const unsigned char *bytes, const int size);
+
+    int messageCount() const { return _messageCount; }
+
+    static const char *magic() { return "MMRC"; }
+    static const quint8 version = 1;
+
+private:
+    MidiRecorder();
+
+    volatile bool _recording;
+    QMutex _mutex;
+    QFile _file;
+    QByteArray _buffer;
+    qint64 _lastTime;
+    int _messageCount;
+    QHash<const MidiInterface*, quint8> _interfaces;
+
+    void appendVarint(quint64 value);
+    void appendString(const QString &string);
+    void flush();
+};
+
+#endif // MIDIRECORDER_H
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midireplayer.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutexLocker>
+
+#include "midi.h"
+#include "midiinterface.h"
+#include "midirecorder.h"
+
+#include "minoprofiler.h"
+
+MidiReplayer::MidiReplayer(Midi *midi, QObject *parent) :
+    QThread(parent),
+    _midi(midi),
+    _speed(1.0),
+    _next(0),
+    _stopped(false)
+{
+    connect(this, SIGNAL(finished()), this, SLOT(releaseInterfaces()));
+}
+
+MidiReplayer::~MidiReplayer()
+{
+    stop();
+    releaseInterfaces();
+}
+
+static bool readVarint(const QByteArray &data, int *pos, quint64 *value)
+{
+    *value = 0;
+    for(int shift=0; (*pos < data.size()) && (shift < 64); shift+=7)
+    {
+        const quint8 byte = data.at((*pos)++);
+        *value |= (quint64)(byte & 0x7f) << shift;
+        if(!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+static bool readString(const QByteArray &data, int *pos, QString *string)
+{
+    if(*pos >= data.size())
+        return false;
+    const int size = (quint8)data.at((*pos)++);
+    if(*pos + size > data.size())
+        return false;
+    *string = QString::fromUtf8(data.constData() + *pos, size);
+    *pos += size;
+    return true;
+}
+
+bool MidiReplayer::load(const QString &fileName)
+{
+    Q_ASSERT(!isRunning());
+    _events.clear();
+    _sources.clear();
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to open" << fileName;
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    if(!data.startsWith(MidiRecorder::magic()) || (data.size() < 5) || ((quint8)data.at(4) != MidiRecorder::version))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "not a MIDI recording:" << fileName;
+        return false;
+    }
+
+    qint64 time = 0;
+    int pos = 5;
+    while(pos < data.size())
+    {
+        quint64 delta;
+        if(!readVarint(data, &pos, &delta) || (pos + 2 > data.size()))
+            break;
+        time += delta;
+        const int source = (quint8)data.at(pos++);
+        const int size = (quint8)data.at(pos++);
+        if(size == 0)
+        {
+            Source declaration;
+            if(!readString(data, &pos, &declaration.portName) || !readString(data, &pos, &declaration.mapping))
+                break;
+            if(source != _sources.count())
+                break;
+            _sources.append(declaration);
+        }
+        else
+        {
+            if((pos + size > data.size()) || (source >= _sources.count()))
+                break;
+            Event event;
+            event.time = time;
+            event.source = source;
+            event.bytes = data.mid(pos, size);
+            _events.append(event);
+            pos += size;
+        }
+    }
+    if(pos < data.size())
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "truncated recording:" << fileName << "read" << _events.count() << "messages";
+    }
+    return !_events.isEmpty();
+}
+
+void MidiReplayer::createInterfaces()
+{
+    releaseInterfaces();
+
+    // Interfaces are created in caller's thread (ie. MidiMapper is not thread-safe)
+    foreach(const Source &source, _sources)
+    {
+        MidiInterface *interface = _midi->addMidiInterface(QString("%1 (replay)").arg(source.portName), MidiInterface::Replay);
+        interface->setMapping(source.mapping);
+        interface->open();
+        _interfaces.append(interface);
+    }
+}
+
+void MidiReplayer::play(const qreal speed)
+{
+    stop();
+    createInterfaces();
+
+    _speed = qMax((qreal)0.0, speed);
+    _stopped = false;
+    start();
+}
+
+void MidiReplayer::rewind()
+{
+    stop();
+    createInterfaces();
+    _next = 0;
+}
+
+bool MidiReplayer::deliverUntil(const qint64 time)
+{
+    Q_ASSERT(!isRunning());
+    while((_next < _events.count()) && (_events.at(_next).time <= time))
+    {
+        const Event &event = _events.at(_next++);
+        std::vector<unsigned char> message(event.bytes.constData(), event.bytes.constData() + event.bytes.size());
+        _interfaces.at(event.source)->receive(&message, event.time * 1000);
+    }
+    return _next < _events.count();
+}
+
+void MidiReplayer::stop()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _stopped = true;
+        _stopCondition.wakeAll();
+    }
+    wait();
+}
+
+void MidiReplayer::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+    foreach(const Event &event, _events)
+    {
+        if(_speed > 0.0)
+        {
+            // Wait for message's time (interrupted by stop())
+            const qint64 due = (qint64)((qreal)event.time / _speed);
+            QMutexLocker locker(&_mutex);
+            qint64 now = timer.nsecsElapsed() / 1000;
+            while(!_stopped && (now < due))
+            {
+                _stopCondition.wait(&_mutex, qMax((qint64)1, (due - now) / 1000));
+                now = timer.nsecsElapsed() / 1000;
+            }
+        }
+        if(_stopped)
+            break;
+        std::vector<unsigned char> message(event.bytes.constData(), event.bytes.constData() + event.bytes.size());
+        _interfaces.at(event.source)->receive(&message, MinoProfiler::now());
+    }
+    qDebug() << Q_FUNC_INFO
+             << "replay done in" << timer.elapsed() << "ms (recorded:" << duration() / 1000 << "ms)";
+}
+
+void MidiReplayer::releaseInterfaces()
+{
+    if(isRunning())
+        return;
+    foreach(MidiInterface *interface, _interfaces)
+    {
+        interface->close();
+        delete interface;
+    }
+    _interfaces.clear();
+}
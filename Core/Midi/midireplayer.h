@@ -0,0 +1,92 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDIREPLAYER_H
+#define MIDIREPLAYER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QList>
+
+class Midi;
+class MidiInterface;
+
+// Plays back a MidiRecorder log: messages are fed to replay interfaces (one per recorded interface,
+// using the recorded mapping) exactly as if they were received from the devices.
+class MidiReplayer : public QThread
+{
+    Q_OBJECT
+public:
+    explicit MidiReplayer(Midi *midi, QObject *parent = 0);
+    ~MidiReplayer();
+
+    bool load(const QString &fileName);
+    int messageCount() const { return _events.count(); }
+    // Recording duration in microseconds
+    qint64 duration() const { return _events.isEmpty() ? 0 : _events.last().time; }
+
+    // speed: 1.0 for real time, 2.0 for twice faster, etc. 0 delivers messages as fast as possible
+    void play(const qreal speed = 1.0);
+    void stop();
+
+    // Synchronous playback, driven by caller (ie. offline rendering):
+    // rewind() creates replay interfaces, then deliverUntil() feeds, in caller's thread, messages up to time
+    // (microseconds since first message) and returns false once all messages are delivered.
+    // Messages are timestamped in recording's timebase (nanoseconds since first message).
+    void rewind();
+    bool deliverUntil(const qint64 time);
+
+protected:
+    void run();
+
+private slots:
+    void releaseInterfaces();
+
+private:
+    struct Event
+    {
+        qint64 time; // microseconds since first message
+        int source;
+        QByteArray bytes;
+    };
+    struct Source
+    {
+        QString portName;
+        QString mapping;
+    };
+
+    Midi *_midi;
+    QVector<Event> _events;
+    QList<Source> _sources;
+    QList<MidiInterface*> _interfaces;
+    qreal _speed;
+    int _next;
+
+    void createInterfaces();
+
+    QMutex _mutex;
+    QWaitCondition _stopCondition;
+    volatile bool _stopped;
+};
+
+#endif // MIDIREPLAYER_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ledcolorpipeline.h"
+
+#include <qmath.h>
+
+LedColorPipeline::LedColorPipeline() :
+    _gamma(1.0),
+    _whiteBalance(Qt::white),
+    _brightness(1.0),
+    _dithering(false)
+{
+    computeLookUpTable();
+}
+
+void LedColorPipeline::setGamma(const qreal gamma)
+{
+    if(gamma > 0.0)
+    {
+        _gamma = gamma;
+        computeLookUpTable();
+    }
+}
+
+void LedColorPipeline::setWhiteBalance(const QColor &color)
+{
+    if(color.isValid())
+    {
+        _whiteBalance = color;
+        computeLookUpTable();
+    }
+}
+
+void LedColorPipeline::setBrightness(const qreal brightness)
+{
+    _brightness = qBound(0.0, brightness, 1.0);
+    computeLookUpTable();
+}
+
+void LedColorPipeline::setDithering(const bool on)
+{
+    _dithering = on;
+    _residuals.fill(0);
+}
+
+void LedColorPipeline::setSubPixelCount(const int count)
+{
+    _residuals.fill(0, count);
+}
+
+void LedColorPipeline::computeLookUpTable()
+{
+    const qreal gains[ChannelCount] = {
+        _whiteBalance.redF() * _brightness,
+        _whiteBalance.greenF() * _brightness,
+        _whiteBalance.blueF() * _brightness
+    };
+
+    for(int c=0; c<ChannelCount; c++)
+    {
+        for(int i=0; i<256; i++)
+        {
+            // 255.0 * 256.0 is full scale in 8.8 fixed-point
+            const qreal v = qPow((qreal)i/255.0, _gamma) * gains[c];
+            _lut[c][i] = (quint16)qBound(0, qRound(v * 255.0 * 256.0), 0xffff);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEDCOLORPIPELINE_H
+#define LEDCOLORPIPELINE_H
+
+#include <QColor>
+#include <QByteArray>
+
+// Output color stage of a LED matrix: gamma, white balance and brightness are
+// folded into one 8.8 fixed-point look-up table per channel, so the whole
+// correction costs a table read per sub-pixel while the framebuffer is filled.
+// Optional temporal dithering keeps the fractional part of each sub-pixel from
+// one frame to the next, which smooths low-brightness fades.
+class LedColorPipeline
+{
+public:
+    enum Channel {
+        Red = 0,
+        Green,
+        Blue,
+        ChannelCount
+    };
+
+    LedColorPipeline();
+
+    qreal gamma() const { return _gamma; }
+    void setGamma(const qreal gamma);
+
+    // Per-channel gains (white is neutral)
+    QColor whiteBalance() const { return _whiteBalance; }
+    void setWhiteBalance(const QColor &color);
+
+    qreal brightness() const { return _brightness; }
+    void setBrightness(const qreal brightness);
+
+    bool isDithering() const { return _dithering; }
+    void setDithering(const bool on);
+
+    // Resize dithering accumulators (one per sub-pixel)
+    void setSubPixelCount(const int count);
+
+    // Returns corrected 8-bit value of sub-pixel #subPixel
+    inline quint8 map(const Channel channel, const quint8 value, const int subPixel)
+    {
+        const unsigned int v = _lut[channel][value];
+        if(_dithering)
+        {
+            uchar &residual = reinterpret_cast<uchar*>(_residuals.data())[subPixel];
+            const unsigned int acc = v + residual;
+            residual = acc & 0xff;
+            return qMin(acc >> 8, 255u);
+        }
+        return qMin((v + 0x80) >> 8, 255u);
+    }
+
+private:
+    qreal _gamma;
+    QColor _whiteBalance;
+    qreal _brightness;
+    bool _dithering;
+
+    void computeLookUpTable();
+    quint16 _lut[ChannelCount][256];
+
+    QByteArray _residuals;
+};
+
+#endif // LEDCOLORPIPELINE_H
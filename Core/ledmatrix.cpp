@@ -20,6 +20,9 @@
 
 #include "ledmatrix.h"
 
+#include "minoprofiler.h"
+#include "minodownsampler.h"
+
 #include <QImage>
 #include <QDebug>
 #include <QPainter>
@@ -29,7 +32,8 @@ LedMatrix::LedMatrix(const QSize size, const QSize panelSize, const QSize matrix
     _panelSize(panelSize),
     _matrixSize(matrixSize),
     _port(NULL),
-    _connected(false)
+    _connected(false),
+    _output(NULL)
 {
     _port = new QextSerialPort();
 
@@ -50,6 +54,7 @@ bool LedMatrix::openPortByName(const QString& portName)
     if (_port->open(QIODevice::WriteOnly)){
         qDebug() << "Led matrix connected to:" << this->portName();
         _connected = true;
+        _output = _port;
         emit(connected());
     } else {
         qDebug() << "Led matrix failed to connect to:" << portName;
@@ -63,6 +68,8 @@ void LedMatrix::closePort()
         _port->close();
         qDebug() << "Led matrix disconnected.";
         _connected = false;
+        if(_output == _port)
+            _output = NULL;
         emit(connected(false));
     }
 }
@@ -99,6 +106,7 @@ void LedMatrix::prepareFramebuffer()
     if(isConfigured())
     {
         _framebuffer.resize(size().width()*size().height()*3);
+        _colorPipeline.setSubPixelCount(_framebuffer.size());
     }
 }
 
@@ -138,38 +146,75 @@ void LedMatrix::computeLookUpTable()
     }
 }
 
+void LedMatrix::setOutputDevice(QIODevice *device)
+{
+    _output = device;
+}
+
 void LedMatrix::show(const QImage *image)
 {
+    if(size().isValid())
+    {
+        map(image);
+        write();
+        emit(updated());
+    }
+}
+
+void LedMatrix::map(const QImage *image)
+{
+    static const int profilerKey = MinoProfiler::profiler()->key("output map");
+    MinoProfilerScope profilerScope(profilerKey);
     const QSize size(this->size());
     if(size.isValid())
     {
-        const unsigned int matrix_width_in_pixels = size.width();
-        const unsigned int matrix_height_in_pixels = size.height();
-        const QRgb *pixels = reinterpret_cast<const QRgb*>(image->bits());
+        if(image->size() != size)
+        {
+            static const int downsampleProfilerKey = MinoProfiler::profiler()->key("output downsample");
+            MinoProfilerScope downsampleProfilerScope(downsampleProfilerKey);
+            if(_downsampled.size() != size)
+                _downsampled = QImage(size, QImage::Format_RGB32);
+            MinoDownsampler::downsample(image, &_downsampled);
+            image = &_downsampled;
+        }
+        // Never read outside of matrix
+        const unsigned int width = qMin(size.width(), image->width());
+        const unsigned int height = qMin(size.height(), image->height());
+        char *framebuffer = _framebuffer.data();
 
-        for (unsigned int y=0;y<matrix_height_in_pixels;y++)
+        for (unsigned int y=0;y<height;y++)
         {
-            for (unsigned int x=0;x<matrix_width_in_pixels;x++) {
+            const QRgb *pixels = reinterpret_cast<const QRgb*>(image->constScanLine(y));
+            for (unsigned int x=0;x<width;x++) {
                 const unsigned int id = _pixelsLUT.data()[x+(y*size.width())];
 
                 const unsigned int r_id = (id * 3) + 1;
                 const unsigned int g_id = (id * 3) + 2;
                 const unsigned int b_id = (id * 3) + 0;
 
-                QRgb rgb = pixels[x+(y*matrix_width_in_pixels)];
+                QRgb rgb = pixels[x];
+
+                const quint8 r = _colorPipeline.map(LedColorPipeline::Red, qRed(rgb), r_id);
+                const quint8 g = _colorPipeline.map(LedColorPipeline::Green, qGreen(rgb), g_id);
+                const quint8 b = _colorPipeline.map(LedColorPipeline::Blue, qBlue(rgb), b_id);
 
-                char *framebuffer = _framebuffer.data();
-                framebuffer[r_id] = (qRed(rgb)==0x01)?0:qRed(rgb);
-                framebuffer[g_id] = (qGreen(rgb)==0x01)?0:qGreen(rgb);
-                framebuffer[b_id] = (qBlue(rgb)==0x01)?0:qBlue(rgb);
+                // 0x01 is reserved as end-of-frame marker
+                framebuffer[r_id] = (r==0x01)?0:r;
+                framebuffer[g_id] = (g==0x01)?0:g;
+                framebuffer[b_id] = (b==0x01)?0:b;
             }
         }
-        if(_connected)
-        {
-            _port->write(_framebuffer.constData(),_framebuffer.size());
-            char endFrame = 0x01;
-            _port->write(&endFrame,1);
-        }
-        emit(updated());
+    }
+}
+
+void LedMatrix::write()
+{
+    static const int profilerKey = MinoProfiler::profiler()->key("output write");
+    MinoProfilerScope profilerScope(profilerKey);
+    if(_output)
+    {
+        _output->write(_framebuffer.constData(),_framebuffer.size());
+        char endFrame = 0x01;
+        _output->write(&endFrame,1);
     }
 }
@@ -27,9 +27,12 @@
 #include <QGraphicsView>
 
 #include <QVarLengthArray>
+#include <QImage>
 
 #include "qextserialport.h"
 
+#include "ledcolorpipeline.h"
+
 class LedMatrix : public QObject
 {
      Q_OBJECT
@@ -43,7 +46,18 @@ public:
 
     bool isConnected();
 
+    // Map image to framebuffer and send it
     void show(const QImage *image);
+    // Map image pixels to framebuffer (panels layout and color correction)
+    // Image is downsampled first if it's not matrix size
+    void map(const QImage *image);
+    // Send framebuffer to output device
+    void write();
+
+    // Output device (serial port by default, or any other sink, ie. for benchmarks)
+    // Note: LedMatrix does not take ownership of device
+    void setOutputDevice(QIODevice *device);
+    QIODevice *outputDevice() const { return _output; }
 
     // Accessors
     // Returns matrix's size in pixels
@@ -55,6 +69,9 @@ public:
     // Returns matrix's size in panels
     QSize matrixSize() const { return _matrixSize; }
 
+    // Output color correction (gamma, white balance, brightness, dithering)
+    LedColorPipeline *colorPipeline() { return &_colorPipeline; }
+
 private:
     QSize _panelSize;
     QSize _matrixSize;
@@ -62,6 +79,7 @@ private:
     // Connection
     QextSerialPort *_port;
     bool _connected;
+    QIODevice *_output;
 
     // Returns true if LedMatrix is fully configured (ie. does have all requiered sizes sets)
     bool isConfigured() const;
@@ -71,6 +89,11 @@ private:
     void computeLookUpTable();
     QVarLengthArray<unsigned int> _pixelsLUT;
 
+    LedColorPipeline _colorPipeline;
+
+    // Rendering brought to matrix size when sizes differ (ie. supersampled rendering)
+    QImage _downsampled;
+
 
 signals:
     void updated();
@@ -23,12 +23,17 @@
 #include "minotor.h"
 #include "minoprogram.h"
 #include "minoanimationgroup.h"
+#include "minoprofiler.h"
 
 MinoAnimation::MinoAnimation(QObject *parent) :
     MinoPersistentObject(parent),
     _group(NULL),
     _enabled(false),
-    _currentRandY(0)
+    _random(MinoRandom::nextSeed()),
+    _currentRandY(0),
+    _profilerKey(-1),
+    _profilerProgramId(-1),
+    _profilerGroupId(-1)
 {
     Q_ASSERT(parent);
     if(MinoAnimationGroup* mag = qobject_cast<MinoAnimationGroup*>(parent))
@@ -45,6 +50,12 @@ MinoAnimation::MinoAnimation(QObject *parent) :
     _beatFactor = new MinoPropertyBeat(this);
 }
 
+MinoAnimation::~MinoAnimation()
+{
+    if(_profilerKey != -1)
+        MinoProfiler::profiler()->removeWindow(_profilerKey);
+}
+
 int MinoAnimation::id()
 {
     return _group->animations().indexOf(this);
@@ -73,6 +84,30 @@ void MinoAnimation::setGroup(MinoAnimationGroup *group)
     }
 }
 
+int MinoAnimation::profilerKey()
+{
+    // Key name embeds program and group ids: it is looked up again when they change (ie. groups reordered)
+    const bool located = _group && _group->program();
+    const int programId = located ? _group->program()->id() : -1;
+    const int groupId = located ? _group->id() : -1;
+    if((_profilerKey == -1) || (programId != _profilerProgramId) || (groupId != _profilerGroupId))
+    {
+        QString name = metaObject()->className();
+        if(located)
+        {
+            name = QString("program %1 / group %2 / %3").arg(programId).arg(groupId).arg(name);
+        }
+        const int key = MinoProfiler::profiler()->key(name);
+        // Samples of previous location are stale
+        if((_profilerKey != -1) && (_profilerKey != key))
+            MinoProfiler::profiler()->removeWindow(_profilerKey);
+        _profilerKey = key;
+        _profilerProgramId = programId;
+        _profilerGroupId = groupId;
+    }
+    return _profilerKey;
+}
+
 void MinoAnimation::setEnabled(const bool on)
 {
     if(on != _enabled)
@@ -30,6 +30,7 @@
 #include "minopropertycolor.h"
 #include "minopropertybeat.h"
 #include "minopersistentobject.h"
+#include "minorandom.h"
 
 class MinoProgram;
 
@@ -59,9 +60,11 @@ class MinoAnimationGroup;
 class MinoAnimation : public MinoPersistentObject
 {
     Q_OBJECT
+    Q_PROPERTY(uint seed READ seed WRITE setSeed STORED true)
 
 public:
     explicit MinoAnimation(QObject *parent);
+    ~MinoAnimation();
 
     int id();
 
@@ -69,16 +72,33 @@ public:
     virtual QGraphicsItem* graphicItem() = 0;
 
     virtual void animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn) = 0;
-
-    static qreal qrandF() { return (qreal)qrand()/RAND_MAX; }
+    // Returns true when drawn content changed since last call (ie. group's layer has to be painted again)
+    // Most animations move their items on every step: static ones override it to let the layer be reused
+    virtual bool takeChanged() { return true; }
+    // Blocks until asynchronous setup (ie. image frames decoded in background) is done
+    // Needed by callers without running event loop (ie. bench, offline renderer)
+    virtual void waitForFrames() { }
+
+    // Random helpers use animation's own generator (see MinoRandom)
+    qreal qrandF() { return _random.nextReal(); }
     QPointF qrandPointF();
     unsigned int qrandY(unsigned int size);
     bool enabled() const { return _enabled; }
     virtual bool isAlive() const { return _enabled; }
+    // Coverage: true when current frame fills the whole bounding rect with opaque pixels
+    // (content of groups below can't be seen, they are not rendered)
+    virtual bool isOpaque() const { return false; }
 
     MinoAnimationGroup* group() const { return _group; }
     void setGroup(MinoAnimationGroup *group);
 
+    // Key used to report animate() timings to MinoProfiler
+    int profilerKey();
+
+    // Random generator seed (persisted: a loaded animation replays the same sequence)
+    uint seed() const { return _random.seed(); }
+    void setSeed(const uint seed) { _random.setSeed(seed); }
+
 public slots:
     void setEnabled(const bool enabled);
 
@@ -95,9 +115,15 @@ protected:
 
     bool _enabled;
 
+    MinoRandom _random;
+
     virtual void setAlive(const bool on) { graphicItem()->setVisible(on); }
 private:
     int _currentRandY;
+    int _profilerKey;
+    // Ids embedded in profiler key name
+    int _profilerProgramId;
+    int _profilerGroupId;
 
 signals:
     void enabledChanged(bool on);
@@ -110,21 +136,24 @@ typedef QList<MinoAnimation*> MinoAnimationList;
 class MinoAnimatedItem
 {
 public:
-    explicit MinoAnimatedItem(const unsigned int startUppqn,const unsigned int duration,QGraphicsItem *graphicsItem):
+    // phase: pulses already elapsed at startUppqn (ie. item triggered between two frames)
+    explicit MinoAnimatedItem(const unsigned int startUppqn,const unsigned int duration,QGraphicsItem *graphicsItem,const qreal phase=0.0):
         _startUppqn(startUppqn),
         _duration(duration),
-        _graphicsItem(graphicsItem)
+        _graphicsItem(graphicsItem),
+        _phase(phase)
     {
     }
 
     unsigned int startUppqn() const { return _startUppqn; }
     unsigned int duration() const { return _duration; }
     QGraphicsItem *graphicsItem() const { return _graphicsItem; }
-    qreal progressForUppqn(const unsigned int uppqn) const { return (qreal)(uppqn - _startUppqn) / (qreal)_duration; }
+    qreal progressForUppqn(const unsigned int uppqn) const { return qMin((qreal)1.0, ((qreal)(uppqn - _startUppqn) + _phase) / (qreal)_duration); }
     bool isCompleted(const unsigned int uppqn) const { return (uppqn > (_startUppqn+_duration)); }
     unsigned int _startUppqn;
     unsigned int _duration;
     QGraphicsItem *_graphicsItem;
+    qreal _phase;
 
 } ;
 
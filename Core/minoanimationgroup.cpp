@@ -21,6 +21,7 @@
 #include "minoanimationgroup.h"
 
 #include <QDebug>
+#include <QPainter>
 
 #include "minoprogram.h"
 #include "minoinstrumentedanimation.h"
@@ -28,12 +29,16 @@
 #include "midicontrollableparameter.h"
 
 #include "minotor.h"
+#include "minoprofiler.h"
+#include "minoitempainter.h"
 
 MinoAnimationGroup::MinoAnimationGroup(QObject *parent) :
     MinoPersistentObject(parent),
     _enabled(false),
     _alive(false),
-    _program(NULL)
+    _program(NULL),
+    _blendMode(MinoCompositor::Normal),
+    _layerDirty(true)
 {
     Q_ASSERT(parent);
     Q_ASSERT(qobject_cast<MinoProgram*>(parent));
@@ -66,6 +71,51 @@ void MinoAnimationGroup::setProgram(MinoProgram *program)
     }
 }
 
+void MinoAnimationGroup::setBlendMode(const int mode)
+{
+    const MinoCompositor::BlendMode blendMode = (MinoCompositor::BlendMode)qBound((int)MinoCompositor::Normal, mode, (int)MinoCompositor::Max);
+    if(_blendMode != blendMode)
+    {
+        _blendMode = blendMode;
+        emit blendModeChanged(_blendMode);
+    }
+}
+
+const QImage *MinoAnimationGroup::layer(const QSize &size, const qreal scale)
+{
+    if(_layer.size() != size)
+    {
+        _layer = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        _layerDirty = true;
+    }
+    if(_layerDirty)
+    {
+        _layer.fill(Qt::transparent);
+        QPainter painter(&_layer);
+        painter.scale(scale, scale);
+        MinoItemPainter::paint(&painter, &_itemGroup);
+        _layerDirty = false;
+    }
+    return &_layer;
+}
+
+bool MinoAnimationGroup::isOpaque() const
+{
+    if((_blendMode != MinoCompositor::Normal) || !_itemGroup.isVisible() || (_itemGroup.opacity() < 1.0))
+        return false;
+    foreach(MinoAnimation *animation, _animations)
+    {
+        if(animation->isAlive() && animation->isOpaque())
+            return true;
+    }
+    return false;
+}
+
+bool MinoAnimationGroup::isVisible() const
+{
+    return MinoItemPainter::isVisible(&_itemGroup);
+}
+
 void MinoAnimationGroup::setScreenshot(const QPixmap &screenshot)
 {
     _screenshot = screenshot;
@@ -112,11 +162,13 @@ void MinoAnimationGroup::insertAnimation(MinoAnimation *animation, int index)
 
     // Will remove animation from list when destroyed
     connect(animation, SIGNAL(destroyed(QObject*)), this, SLOT(destroyAnimation(QObject*)));
+    // Animation shown or hidden alone: layer needs to be painted again
+    connect(animation, SIGNAL(enabledChanged(bool)), this, SLOT(markLayerDirty()));
 
     MinoInstrumentedAnimation *mia = qobject_cast<MinoInstrumentedAnimation*>(animation);
     if(mia)
     {
-        connect(Minotor::minotor()->midi(), SIGNAL(noteChanged(int,quint8,quint8,bool,quint8)), mia, SLOT(handleNoteChange(int,quint8,quint8,bool,quint8)));
+        connect(Minotor::minotor()->midi(), SIGNAL(noteChanged(int,quint8,quint8,bool,quint8,qint64)), mia, SLOT(handleNoteChange(int,quint8,quint8,bool,quint8,qint64)));
     }
 
     // Add to program QGraphicsItemGroup to ease group manipulation (ie. change position, brightness, etc.)
@@ -143,6 +195,7 @@ void MinoAnimationGroup::reorderAnimations()
         ma->setParent(this);
         ma->graphicItem()->setZValue(z);
     }
+    _layerDirty = true;
 }
 
 void MinoAnimationGroup::moveAnimation(int srcIndex, int destIndex, MinoAnimationGroup *destGroup)
@@ -190,7 +243,9 @@ MinoAnimation* MinoAnimationGroup::takeAnimationAt(int index)
 {
     MinoAnimation *animation = _animations.takeAt(index);
     disconnect(animation);
+    disconnect(animation, SIGNAL(enabledChanged(bool)), this, SLOT(markLayerDirty()));
     animation->setGroup(NULL);
+    _layerDirty = true;
     if (_animations.count() == 0)
     {
         this->deleteLater();
@@ -218,6 +273,7 @@ void MinoAnimationGroup::_setEnabled(const bool on)
     {
         animation->setEnabled(on);
     }
+    _layerDirty = true;
 
     // Show _itemGroup (on=true) but do not hide it (on=false):
     //     it will be shuted-down when all animations stopped running..
@@ -231,6 +287,7 @@ void MinoAnimationGroup::_setEnabled(const bool on)
 void MinoAnimationGroup::destroyAnimation(QObject *animation)
 {
     _animations.removeAt(_animations.indexOf(static_cast<MinoAnimation*>(animation)));
+    _layerDirty = true;
     if (_animations.count() == 0)
     {
         this->deleteLater();
@@ -244,7 +301,11 @@ void MinoAnimationGroup::animate(const unsigned int uppqn, const unsigned int gp
     {
         if(ma->isAlive())
         {
+            MinoProfilerScope profilerScope(ma->profilerKey());
             ma->animate(uppqn, gppqn, ppqn, qn);
+            // Layer is painted again only when an animation changed what it draws
+            if(ma->takeChanged())
+                _layerDirty = true;
             alive = true;
         }
     }
@@ -276,5 +337,6 @@ void MinoAnimationGroup::setAlive(const bool on)
     {
         _alive = on;
         _itemGroup.setVisible(on);
+        _layerDirty = true;
     }
 }
@@ -25,8 +25,10 @@
 
 #include <QGraphicsItemGroup>
 #include <QList>
+#include <QImage>
 
 #include "minoanimation.h"
+#include "minocompositor.h"
 
 class MinoProgram;
 
@@ -36,6 +38,8 @@ class MinoAnimationGroup : public MinoPersistentObject
     friend class MinoProgram;
     Q_PROPERTY(bool enabled READ enabled WRITE setEnabled STORED true)
     Q_PROPERTY(QPixmap screenshot READ screenshot WRITE setScreenshot STORED true)
+    // MinoCompositor::BlendMode used to composite group's layer in program
+    Q_PROPERTY(int blendMode READ blendMode WRITE setBlendMode STORED true)
 public:
     explicit MinoAnimationGroup(QObject *parent);
 
@@ -54,6 +58,17 @@ public:
 
     bool enabled() const { return _enabled; }
 
+    int blendMode() const { return _blendMode; }
+    void setBlendMode(const int mode);
+
+    // Group items rendered alone (ARGB32 premultiplied): it is only painted again when group changed
+    // scale: supersampling factor applied to scene coordinates
+    const QImage *layer(const QSize &size, const qreal scale = 1.0);
+    // Occlusion: layer would hide every group below (normal blend mode and an opaque animation)
+    bool isOpaque() const;
+    // Layer would contain at least one non-transparent item
+    bool isVisible() const;
+
     void setAlive() { setAlive(true); }
     bool isAlive() const { return _alive; }
     void animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn);
@@ -80,6 +95,10 @@ private:
     MinoProgram *_program;
     QGraphicsItemGroup _itemGroup;
 
+    MinoCompositor::BlendMode _blendMode;
+    QImage _layer;
+    bool _layerDirty;
+
     // Will be called by MinoProgram
     void _setEnabled(const bool on);
     void reorderAnimations();
@@ -87,6 +106,7 @@ private:
 
 private slots:
     void destroyAnimation(QObject *animation);
+    void markLayerDirty() { _layerDirty = true; }
 
 signals:
     // Signal emitted when group is enabled
@@ -94,6 +114,7 @@ signals:
     void animationAdded(QObject *animation);
     void animationMoved(QObject *animation);
     void screenshotUpdated();
+    void blendModeChanged(int mode);
 };
 
 typedef QList<MinoAnimationGroup*> MinoAnimationGroupList;
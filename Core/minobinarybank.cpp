@@ -0,0 +1,401 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minobinarybank.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QHash>
+#include <QMetaProperty>
+#include <QtEndian>
+
+#define MINOBINARYBANK_MAGIC        "MPBB"
+#define MINOBINARYBANK_VERSION      1
+#define MINOBINARYBANK_NONE         0xffffffff
+
+// Sizes (in bytes) of header and tables entries
+#define MINOBINARYBANK_HEADER_SIZE  44
+#define MINOBINARYBANK_STRING_SIZE  8   // offset, length
+#define MINOBINARYBANK_OBJECT_SIZE  20  // class, name, subtree size, first property, property count
+#define MINOBINARYBANK_PROPERTY_SIZE 12 // name, value offset, value size
+
+enum ObjectField { ObjectClass, ObjectName, ObjectSubtreeSize, ObjectFirstProperty, ObjectPropertyCount };
+enum PropertyField { PropertyName, PropertyValueOffset, PropertyValueSize };
+
+static quint32 readU32(const uchar *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+static void appendU32(QByteArray *array, const quint32 value)
+{
+    uchar bytes[4];
+    qToLittleEndian<quint32>(value, bytes);
+    array->append((const char*)bytes, 4);
+}
+
+// Values are streamed with a fixed QDataStream version: files stay readable by both Qt4 and Qt5 builds
+static void setupStream(QDataStream *stream)
+{
+    stream->setVersion(QDataStream::Qt_4_8);
+}
+
+MinoBinaryBank::MinoBinaryBank(const QString &fileName) :
+    _file(fileName),
+    _data(NULL),
+    _size(0),
+    _stringCount(0),
+    _stringTable(NULL),
+    _stringData(NULL),
+    _stringDataSize(0),
+    _objectCount(0),
+    _objectTable(NULL),
+    _propertyCount(0),
+    _propertyTable(NULL),
+    _valueData(NULL),
+    _valueDataSize(0)
+{
+}
+
+MinoBinaryBank::~MinoBinaryBank()
+{
+    if(_data && _buffer.isEmpty())
+        _file.unmap(const_cast<uchar*>(_data));
+}
+
+bool MinoBinaryBank::isBinaryFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+    return (file.read(4) == QByteArray(MINOBINARYBANK_MAGIC));
+}
+
+bool MinoBinaryBank::open()
+{
+    if(!_file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to open" << _file.fileName();
+        return false;
+    }
+    _size = _file.size();
+    _data = _file.map(0, _size);
+    if(!_data)
+    {
+        // Some file systems don't support mapping
+        _buffer = _file.readAll();
+        _data = (const uchar*)_buffer.constData();
+    }
+
+    if((_size < MINOBINARYBANK_HEADER_SIZE)
+            || (QByteArray((const char*)_data, 4) != QByteArray(MINOBINARYBANK_MAGIC)))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << _file.fileName() << "is not a binary bank";
+        return false;
+    }
+    const quint16 version = qFromLittleEndian<quint16>(_data+4);
+    if(version != MINOBINARYBANK_VERSION)
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unsupported binary bank version:" << version;
+        return false;
+    }
+
+    // Tables location
+    const quint32 stringCount = readU32(_data+8);
+    const quint32 stringTableOffset = readU32(_data+12);
+    const quint32 stringDataOffset = readU32(_data+16);
+    const quint32 objectCount = readU32(_data+20);
+    const quint32 objectTableOffset = readU32(_data+24);
+    const quint32 propertyCount = readU32(_data+28);
+    const quint32 propertyTableOffset = readU32(_data+32);
+    const quint32 valueDataOffset = readU32(_data+36);
+    const quint32 valueDataSize = readU32(_data+40);
+
+    const quint64 size = _size;
+    if(((quint64)stringTableOffset + (quint64)stringCount*MINOBINARYBANK_STRING_SIZE > size)
+            || ((quint64)objectTableOffset + (quint64)objectCount*MINOBINARYBANK_OBJECT_SIZE > size)
+            || ((quint64)propertyTableOffset + (quint64)propertyCount*MINOBINARYBANK_PROPERTY_SIZE > size)
+            || ((quint64)valueDataOffset + valueDataSize > size)
+            || (stringDataOffset > size))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << _file.fileName() << "is truncated";
+        return false;
+    }
+    _stringCount = stringCount;
+    _stringTable = _data + stringTableOffset;
+    _stringData = _data + stringDataOffset;
+    _stringDataSize = size - stringDataOffset;
+    _objectCount = objectCount;
+    _objectTable = _data + objectTableOffset;
+    _propertyCount = propertyCount;
+    _propertyTable = _data + propertyTableOffset;
+    _valueData = _data + valueDataOffset;
+    _valueDataSize = valueDataSize;
+
+    // Check tables consistency once: accessors can then read without bounds checks
+    for(int i=0; i<_stringCount; i++)
+    {
+        const uchar *entry = _stringTable + i*MINOBINARYBANK_STRING_SIZE;
+        if((quint64)readU32(entry) + readU32(entry+4) > _stringDataSize)
+        {
+            qDebug() << Q_FUNC_INFO
+                     << "corrupted string table";
+            return false;
+        }
+    }
+    for(int i=0; i<_objectCount; i++)
+    {
+        const quint32 name = objectField(i, ObjectName);
+        const quint32 subtree = objectField(i, ObjectSubtreeSize);
+        if((objectField(i, ObjectClass) >= (quint32)_stringCount)
+                || ((name != MINOBINARYBANK_NONE) && (name >= (quint32)_stringCount))
+                || (subtree == 0) || ((quint64)i + subtree > (quint64)_objectCount)
+                || ((quint64)objectField(i, ObjectFirstProperty) + objectField(i, ObjectPropertyCount) > (quint64)_propertyCount))
+        {
+            qDebug() << Q_FUNC_INFO
+                     << "corrupted object table";
+            return false;
+        }
+    }
+    for(int i=0; i<_propertyCount; i++)
+    {
+        const uchar *entry = _propertyTable + i*MINOBINARYBANK_PROPERTY_SIZE;
+        if((readU32(entry) >= (quint32)_stringCount)
+                || ((quint64)readU32(entry+4) + readU32(entry+8) > _valueDataSize))
+        {
+            qDebug() << Q_FUNC_INFO
+                     << "corrupted property table";
+            return false;
+        }
+    }
+    return true;
+}
+
+QString MinoBinaryBank::string(const quint32 index) const
+{
+    if(index >= (quint32)_stringCount)
+        return QString();
+    const uchar *entry = _stringTable + index*MINOBINARYBANK_STRING_SIZE;
+    return QString::fromUtf8((const char*)_stringData + readU32(entry), readU32(entry+4));
+}
+
+quint32 MinoBinaryBank::objectField(const int object, const int field) const
+{
+    Q_ASSERT((object >= 0) && (object < _objectCount));
+    return readU32(_objectTable + object*MINOBINARYBANK_OBJECT_SIZE + field*4);
+}
+
+quint32 MinoBinaryBank::propertyField(const int object, const int property, const int field) const
+{
+    Q_ASSERT((property >= 0) && (property < propertyCount(object)));
+    const quint32 index = objectField(object, ObjectFirstProperty) + property;
+    return readU32(_propertyTable + index*MINOBINARYBANK_PROPERTY_SIZE + field*4);
+}
+
+QString MinoBinaryBank::className(const int object) const
+{
+    return string(objectField(object, ObjectClass));
+}
+
+QString MinoBinaryBank::objectName(const int object) const
+{
+    return string(objectField(object, ObjectName));
+}
+
+int MinoBinaryBank::subtreeSize(const int object) const
+{
+    return objectField(object, ObjectSubtreeSize);
+}
+
+QList<int> MinoBinaryBank::children(const int object) const
+{
+    QList<int> children;
+    const int end = object + subtreeSize(object);
+    for(int i=object+1; i<end; i+=subtreeSize(i))
+        children.append(i);
+    return children;
+}
+
+QList<int> MinoBinaryBank::roots() const
+{
+    QList<int> roots;
+    for(int i=0; i<_objectCount; i+=subtreeSize(i))
+        roots.append(i);
+    return roots;
+}
+
+int MinoBinaryBank::propertyCount(const int object) const
+{
+    return objectField(object, ObjectPropertyCount);
+}
+
+QString MinoBinaryBank::propertyName(const int object, const int property) const
+{
+    return string(propertyField(object, property, PropertyName));
+}
+
+QVariant MinoBinaryBank::propertyValue(const int object, const int property) const
+{
+    const QByteArray blob = QByteArray::fromRawData((const char*)_valueData + propertyField(object, property, PropertyValueOffset),
+                                                    propertyField(object, property, PropertyValueSize));
+    QDataStream stream(blob);
+    setupStream(&stream);
+    QVariant value;
+    stream >> value;
+    return value;
+}
+
+// Writer
+
+class MinoBinaryBankWriter
+{
+public:
+    MinoBinaryBankWriter() : _propertyCount(0) { }
+
+    void add(MinoPersistentObject *object);
+    bool write(const QString &fileName);
+
+private:
+    QHash<QString, quint32> _strings;
+    QByteArray _stringTable;
+    QByteArray _stringData;
+    QList<QByteArray> _objects; // Entries are patched with subtree size once children are known
+    QByteArray _propertyTable;
+    quint32 _propertyCount;
+    QByteArray _valueData;
+
+    quint32 intern(const QString &string);
+};
+
+quint32 MinoBinaryBankWriter::intern(const QString &string)
+{
+    QHash<QString, quint32>::const_iterator it = _strings.constFind(string);
+    if(it != _strings.constEnd())
+        return it.value();
+    const QByteArray utf8 = string.toUtf8();
+    const quint32 index = _strings.count();
+    appendU32(&_stringTable, _stringData.size());
+    appendU32(&_stringTable, utf8.size());
+    _stringData.append(utf8);
+    _strings.insert(string, index);
+    return index;
+}
+
+void MinoBinaryBankWriter::add(MinoPersistentObject *object)
+{
+    // HACK to transform hardcoded programs into a simple -and instantiable- MinoProgram (see Minotor::save)
+    QString className = object->metaObject()->className();
+    if(object->metaObject()->superClass() && (QString(object->metaObject()->superClass()->className()) == QString("MinoProgram")))
+        className = "MinoProgram";
+
+    const int index = _objects.count();
+    _objects.append(QByteArray());
+
+    // Properties: objectName is stored in object table
+    const quint32 firstProperty = _propertyCount;
+    for(int j=0; j<object->metaObject()->propertyCount(); j++)
+    {
+        QMetaProperty omp = object->metaObject()->property(j);
+        if(QString(omp.name()) != QString("objectName"))
+        {
+            QByteArray blob;
+            QDataStream stream(&blob, QIODevice::WriteOnly);
+            setupStream(&stream);
+            stream << omp.read(object);
+
+            appendU32(&_propertyTable, intern(omp.name()));
+            appendU32(&_propertyTable, _valueData.size());
+            appendU32(&_propertyTable, blob.size());
+            _valueData.append(blob);
+            _propertyCount++;
+        }
+    }
+
+    foreach(QObject* o, object->children())
+    {
+        if(MinoPersistentObject* mpo = qobject_cast<MinoPersistentObject*>(o))
+            add(mpo);
+    }
+
+    QByteArray entry;
+    appendU32(&entry, intern(className));
+    appendU32(&entry, object->objectName().isEmpty() ? MINOBINARYBANK_NONE : intern(object->objectName()));
+    appendU32(&entry, _objects.count() - index);
+    appendU32(&entry, firstProperty);
+    appendU32(&entry, _propertyCount - firstProperty);
+    _objects[index] = entry;
+}
+
+bool MinoBinaryBankWriter::write(const QString &fileName)
+{
+    QByteArray objectTable;
+    foreach(const QByteArray &entry, _objects)
+        objectTable.append(entry);
+
+    const quint32 stringTableOffset = MINOBINARYBANK_HEADER_SIZE;
+    const quint32 objectTableOffset = stringTableOffset + _stringTable.size();
+    const quint32 propertyTableOffset = objectTableOffset + objectTable.size();
+    const quint32 valueDataOffset = propertyTableOffset + _propertyTable.size();
+    const quint32 stringDataOffset = valueDataOffset + _valueData.size();
+
+    QByteArray header(MINOBINARYBANK_MAGIC);
+    uchar version[4];
+    qToLittleEndian<quint16>(MINOBINARYBANK_VERSION, version);
+    qToLittleEndian<quint16>(0, version+2);
+    header.append((const char*)version, 4);
+    appendU32(&header, _strings.count());
+    appendU32(&header, stringTableOffset);
+    appendU32(&header, stringDataOffset);
+    appendU32(&header, _objects.count());
+    appendU32(&header, objectTableOffset);
+    appendU32(&header, _propertyCount);
+    appendU32(&header, propertyTableOffset);
+    appendU32(&header, valueDataOffset);
+    appendU32(&header, _valueData.size());
+    Q_ASSERT(header.size() == MINOBINARYBANK_HEADER_SIZE);
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to open" << fileName;
+        return false;
+    }
+    file.write(header);
+    file.write(_stringTable);
+    file.write(objectTable);
+    file.write(_propertyTable);
+    file.write(_valueData);
+    file.write(_stringData);
+    return (file.error() == QFile::NoError);
+}
+
+bool MinoBinaryBank::write(MinoPersistentObject *object, const QString &fileName)
+{
+    Q_ASSERT(object);
+    MinoBinaryBankWriter writer;
+    writer.add(object);
+    return writer.write(fileName);
+}
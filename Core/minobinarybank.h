@@ -0,0 +1,96 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOBINARYBANK_H
+#define MINOBINARYBANK_H
+
+#include <QFile>
+#include <QString>
+#include <QVariant>
+
+#include "minopersistentobject.h"
+
+// Compact binary persistence of MinoPersistentObject trees (program banks, programs)
+//
+// File is mapped in memory and read in place: only the tables are validated when
+// opened, property values are decoded when their object is materialized.
+//
+// Layout (little endian):
+//   header         magic "MPBB", version, tables offsets and counts
+//   strings        interned class, object and property names (UTF-8)
+//   objects        flat table in depth-first order: class, name, subtree size, properties range
+//   properties     flat table: name, value offset and size
+//   values         QDataStream serialized QVariant blobs
+class MinoBinaryBank
+{
+public:
+    explicit MinoBinaryBank(const QString &fileName);
+    ~MinoBinaryBank();
+
+    // Returns true when file starts with binary bank magic
+    static bool isBinaryFile(const QString &fileName);
+
+    // Serialize object and its persistent children to fileName
+    static bool write(MinoPersistentObject *object, const QString &fileName);
+
+    // Map and validate file
+    bool open();
+    QString fileName() const { return _file.fileName(); }
+
+    // Objects table
+    int objectCount() const { return _objectCount; }
+    QString className(const int object) const;
+    QString objectName(const int object) const;
+    // Number of objects in subtree (object included)
+    int subtreeSize(const int object) const;
+    // Direct children indexes
+    QList<int> children(const int object) const;
+    // Top-level objects indexes
+    QList<int> roots() const;
+
+    // Properties (values are decoded on call)
+    int propertyCount(const int object) const;
+    QString propertyName(const int object, const int property) const;
+    QVariant propertyValue(const int object, const int property) const;
+
+private:
+    QFile _file;
+    QByteArray _buffer; // Used when file can't be mapped
+    const uchar *_data;
+    qint64 _size;
+
+    int _stringCount;
+    const uchar *_stringTable;
+    const uchar *_stringData;
+    quint32 _stringDataSize;
+    int _objectCount;
+    const uchar *_objectTable;
+    int _propertyCount;
+    const uchar *_propertyTable;
+    const uchar *_valueData;
+    quint32 _valueDataSize;
+
+    QString string(const quint32 index) const;
+    quint32 objectField(const int object, const int field) const;
+    quint32 propertyField(const int object, const int property, const int field) const;
+};
+
+#endif // MINOBINARYBANK_H
@@ -24,14 +24,17 @@
 #include <QDebug>
 
 #include "minotor.h"
+#include "minoprofiler.h"
 
 MinoClockSource::MinoClockSource(QObject *parent) :
     QObject(parent),
     _gppqn(0),
     _uppqn(0),
+    _pulseTimestamp(0),
     _bpmValuesCount(0),
     _bpmValuesIndex(0),
     _isEnabled(false),
+    _manual(false),
     _useExternalMidiClock(false)
 {
     // BPM Tapping
@@ -52,13 +55,14 @@ MinoClockSource::MinoClockSource(QObject *parent) :
 void MinoClockSource::internalTimerTimeout()
 {
     if(!_useExternalMidiClock) {
-        sendClock();
+        sendClock(MinoProfiler::now());
     }
 }
 
-void MinoClockSource::sendClock()
+void MinoClockSource::sendClock(const qint64 timestamp)
 {
     const unsigned int ppqn = _gppqn%24;
+    _pulseTimestamp = timestamp;
     emit clock(_uppqn, _gppqn, ppqn, _gppqn/24);
     _uppqn++;
     _gppqn = (_gppqn + 1)%(24*16);
@@ -145,7 +149,7 @@ void MinoClockSource::midiClock()
 {
     if(_useExternalMidiClock)
     {
-        sendClock();
+        sendClock(MinoProfiler::now());
     }
 }
 
@@ -156,7 +160,7 @@ void MinoClockSource::setEnabled(const bool on)
         _isEnabled = on;
         if(on)
         {
-            if (!_useExternalMidiClock)
+            if (!_useExternalMidiClock && !_manual)
             {
                 _internalTimer.start();
             }
@@ -179,7 +183,7 @@ void MinoClockSource::setExternalClockSource(bool on)
         _useExternalMidiClock = on;
         if(!on)
         {
-            if (_isEnabled) { _internalTimer.start(); }
+            if (_isEnabled && !_manual) { _internalTimer.start(); }
         }
         else
         {
@@ -189,6 +193,15 @@ void MinoClockSource::setExternalClockSource(bool on)
     }
 }
 
+void MinoClockSource::setManual(const bool on)
+{
+    _manual = on;
+    if(on)
+        _internalTimer.stop();
+    else if(_isEnabled && !_useExternalMidiClock)
+        _internalTimer.start();
+}
+
 void MinoClockSource::midiStop()
 {
     setEnabled(false);
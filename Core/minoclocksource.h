@@ -36,6 +36,18 @@ public:
     void setMidiClockSource(Midi *midi);
     qreal bpm() const { return (60000.0 / _bpmPeriodMs); }
     unsigned int uppqn() const { return _uppqn; }
+    // Time of last emitted pulse (MinoProfiler::now() timebase) and current pulse period in nanoseconds:
+    // let receivers place asynchronous events (ie. MIDI notes) between two pulses
+    qint64 pulseTimestamp() const { return _pulseTimestamp; }
+    qreal pulseDuration() const { return _bpmPeriodMs * 1000000.0 / 24.0; }
+    bool isEnabled() const { return _isEnabled; }
+
+    // Manual mode: internal timer never runs, caller drives the clock with pulse()
+    // (ie. offline rendering, as fast as frames can be computed)
+    bool isManual() const { return _manual; }
+    void setManual(const bool on);
+    // timestamp: pulse time in notes' timebase (see pulseTimestamp())
+    void pulse(const qint64 timestamp) { sendClock(timestamp); }
 signals:
     // Signal emitting a pre-computed pulse-per-quarter-note and quarter-note id (less code in receiver-classes, ie. MinoAnimations)
     void clock(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn);
@@ -68,6 +80,7 @@ private:
     // 24 ppqn * 16 qn = 384 gppqn
     unsigned int _gppqn;
     unsigned int _uppqn;
+    qint64 _pulseTimestamp;
 
     // Current tempo, please note that we don't store in BPM unit to prevent from precision lose
     qreal _bpmPeriodMs; // Unit is milliseconds between two beats
@@ -84,11 +97,12 @@ private:
 
     // Running status
     bool _isEnabled; // sets when clock source is active.
+    bool _manual;
     void setEnabled(const bool on); // Accessor
 
     // MIDI
     bool _useExternalMidiClock; // 'true' when clock source comes from external (MIDI clock), 'false' when internal generator is used (Timer)
-    void sendClock();
+    void sendClock(const qint64 timestamp);
 
 private slots:
     // MIDI
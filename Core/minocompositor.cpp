@@ -0,0 +1,129 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minocompositor.h"
+
+// Pixels are processed as two 16 bits lanes (red/blue and alpha/green) to blend 2 channels per operation
+#define MINOCOMPOSITOR_RB_MASK 0x00ff00ff
+#define MINOCOMPOSITOR_AG_MASK 0xff00ff00
+
+// x * a / 255 on both lanes (a in range [0-255])
+static inline quint32 multiplyLanes(const quint32 x, const quint32 a)
+{
+    quint32 t = (x & MINOCOMPOSITOR_RB_MASK) * a;
+    t = (t + ((t >> 8) & MINOCOMPOSITOR_RB_MASK) + 0x00800080) >> 8;
+    t &= MINOCOMPOSITOR_RB_MASK;
+
+    quint32 u = ((x >> 8) & MINOCOMPOSITOR_RB_MASK) * a;
+    u = (u + ((u >> 8) & MINOCOMPOSITOR_RB_MASK) + 0x00800080);
+    u &= MINOCOMPOSITOR_AG_MASK;
+    return t | u;
+}
+
+// Per channel saturated sum
+static inline quint32 addSaturate(const quint32 s, const quint32 d)
+{
+    quint32 rb = (s & MINOCOMPOSITOR_RB_MASK) + (d & MINOCOMPOSITOR_RB_MASK);
+    rb |= 0x01000100 - ((rb >> 8) & 0x00010001);
+    quint32 ag = ((s >> 8) & MINOCOMPOSITOR_RB_MASK) + ((d >> 8) & MINOCOMPOSITOR_RB_MASK);
+    ag |= 0x01000100 - ((ag >> 8) & 0x00010001);
+    return (rb & MINOCOMPOSITOR_RB_MASK) | ((ag & MINOCOMPOSITOR_RB_MASK) << 8);
+}
+
+// Per channel x * y / 255
+static inline quint32 multiplyChannels(const quint32 x, const quint32 y)
+{
+    quint32 result = 0;
+    for(int shift=0; shift<32; shift+=8)
+    {
+        quint32 t = ((x >> shift) & 0xff) * ((y >> shift) & 0xff) + 0x80;
+        t = (t + (t >> 8)) >> 8;
+        result |= t << shift;
+    }
+    return result;
+}
+
+// Per channel maximum
+static inline quint32 maxChannels(const quint32 x, const quint32 y)
+{
+    quint32 result = 0;
+    for(int shift=0; shift<32; shift+=8)
+    {
+        result |= qMax((x >> shift) & 0xff, (y >> shift) & 0xff) << shift;
+    }
+    return result;
+}
+
+static inline quint32 blend(const quint32 s, const quint32 d, const MinoCompositor::BlendMode mode)
+{
+    const quint32 alpha = s >> 24;
+    switch(mode)
+    {
+    case MinoCompositor::Normal:
+        return s + multiplyLanes(d, 255 - alpha);
+    case MinoCompositor::Add:
+        return addSaturate(s, d);
+    case MinoCompositor::Screen:
+        // s + d - s*d
+        return s + d - multiplyChannels(s, d);
+    case MinoCompositor::Multiply:
+        // s*d + d*(1-a)
+        return addSaturate(multiplyChannels(s, d), multiplyLanes(d, 255 - alpha));
+    case MinoCompositor::Max:
+        return maxChannels(s, d);
+    }
+    return d;
+}
+
+void MinoCompositor::composite(QImage *destination, const QList<Layer> &layers)
+{
+    Q_ASSERT(destination->format() == QImage::Format_RGB32);
+
+    // Layers must match destination format and size
+    QList<Layer> validLayers;
+    foreach(const Layer &layer, layers)
+    {
+        if((layer.image->format() == QImage::Format_ARGB32_Premultiplied) && (layer.image->size() == destination->size()))
+            validLayers.append(layer);
+    }
+    if(validLayers.isEmpty())
+        return;
+
+    const int width = destination->width();
+    const int height = destination->height();
+    const int layerCount = validLayers.count();
+    for(int y=0; y<height; y++)
+    {
+        quint32 *line = reinterpret_cast<quint32*>(destination->scanLine(y));
+        for(int l=0; l<layerCount; l++)
+        {
+            const Layer &layer = validLayers.at(l);
+            const quint32 *source = reinterpret_cast<const quint32*>(layer.image->constScanLine(y));
+            const BlendMode mode = layer.mode;
+            for(int x=0; x<width; x++)
+            {
+                // Fully transparent pixels never change destination
+                if(source[x])
+                    line[x] = blend(source[x], line[x], mode) | 0xff000000;
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOCOMPOSITOR_H
+#define MINOCOMPOSITOR_H
+
+#include <QImage>
+#include <QList>
+
+// Blends layers (ARGB32 premultiplied) onto an opaque RGB32 image.
+// Destination is walked once, row by row: each row stays in cache while all layers are blended onto it.
+class MinoCompositor
+{
+public:
+    // Modes are applied to premultiplied source (ie. transparent pixels never change destination)
+    enum BlendMode {
+        Normal,     // Source over
+        Add,        // Saturated sum
+        Screen,     // 1 - (1-s)*(1-d)
+        Multiply,   // s*d + d*(1-a)
+        Max         // Per channel maximum
+    };
+
+    struct Layer
+    {
+        Layer(const QImage *image = NULL, const BlendMode mode = Normal) : image(image), mode(mode) { }
+        const QImage *image;
+        BlendMode mode;
+    };
+
+    static void composite(QImage *destination, const QList<Layer> &layers);
+};
+
+#endif // MINOCOMPOSITOR_H
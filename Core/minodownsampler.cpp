@@ -0,0 +1,119 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minodownsampler.h"
+
+#include <QVarLengthArray>
+
+// Pixels are summed as two 16 bits lanes (red/blue and alpha/green): 8 bits of headroom per channel,
+// so a box can cover up to 256 source pixels
+#define MINODOWNSAMPLER_RB_MASK 0x00ff00ff
+#define MINODOWNSAMPLER_MAX_BOX_AREA 256
+
+// Source pixels [start,end) covered by each destination pixel (at least one)
+static void computeSpans(const int sourceLength, const int destinationLength, QVarLengthArray<int> *starts, QVarLengthArray<int> *ends)
+{
+    starts->resize(destinationLength);
+    ends->resize(destinationLength);
+    for(int i=0; i<destinationLength; i++)
+    {
+        const int start = qMin((i * sourceLength) / destinationLength, sourceLength - 1);
+        const int end = ((i + 1) * sourceLength) / destinationLength;
+        starts->data()[i] = start;
+        ends->data()[i] = qMax(start + 1, end);
+    }
+}
+
+// sum / count on one lane, rounded (reciprocal is 65536/count)
+static inline quint32 divideLane(const quint32 sum, const quint32 reciprocal)
+{
+    return qMin<quint32>(255, ((sum * reciprocal) + 0x8000) >> 16);
+}
+
+void MinoDownsampler::downsample(const QImage *source, QImage *destination)
+{
+    Q_ASSERT(destination->format() == QImage::Format_RGB32);
+    const int sourceWidth = source->width();
+    const int sourceHeight = source->height();
+    const int width = destination->width();
+    const int height = destination->height();
+    if(!sourceWidth || !sourceHeight || !width || !height)
+        return;
+
+    if((source->format() != QImage::Format_RGB32) && (source->format() != QImage::Format_ARGB32_Premultiplied))
+    {
+        const QImage converted = source->convertToFormat(QImage::Format_RGB32);
+        downsample(&converted, destination);
+        return;
+    }
+
+    // Boxes too large for lanes headroom: let Qt do the filtering
+    const int boxWidth = (sourceWidth + width - 1) / width;
+    const int boxHeight = (sourceHeight + height - 1) / height;
+    if((boxWidth * boxHeight) > MINODOWNSAMPLER_MAX_BOX_AREA)
+    {
+        *destination = source->scaled(destination->size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation).convertToFormat(QImage::Format_RGB32);
+        return;
+    }
+
+    QVarLengthArray<int> xStarts, xEnds, yStarts, yEnds;
+    computeSpans(sourceWidth, width, &xStarts, &xEnds);
+    computeSpans(sourceHeight, height, &yStarts, &yEnds);
+
+    // Per destination pixel lane sums of the current destination row
+    QVarLengthArray<quint32> rbSums(width);
+    QVarLengthArray<quint32> agSums(width);
+
+    for(int y=0; y<height; y++)
+    {
+        memset(rbSums.data(), 0, width * sizeof(quint32));
+        memset(agSums.data(), 0, width * sizeof(quint32));
+
+        // Source rows are walked once, sequentially
+        for(int sy=yStarts[y]; sy<yEnds[y]; sy++)
+        {
+            const quint32 *pixels = reinterpret_cast<const quint32*>(source->constScanLine(sy));
+            for(int x=0; x<width; x++)
+            {
+                quint32 rb = 0;
+                quint32 ag = 0;
+                for(int sx=xStarts[x]; sx<xEnds[x]; sx++)
+                {
+                    rb += pixels[sx] & MINODOWNSAMPLER_RB_MASK;
+                    ag += (pixels[sx] >> 8) & MINODOWNSAMPLER_RB_MASK;
+                }
+                rbSums[x] += rb;
+                agSums[x] += ag;
+            }
+        }
+
+        const quint32 rows = yEnds[y] - yStarts[y];
+        quint32 *line = reinterpret_cast<quint32*>(destination->scanLine(y));
+        for(int x=0; x<width; x++)
+        {
+            const quint32 reciprocal = 65536 / (rows * (xEnds[x] - xStarts[x]));
+            const quint32 r = divideLane(rbSums[x] >> 16, reciprocal);
+            const quint32 g = divideLane(agSums[x] & 0xffff, reciprocal);
+            const quint32 b = divideLane(rbSums[x] & 0xffff, reciprocal);
+            line[x] = 0xff000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+}
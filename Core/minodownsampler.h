@@ -0,0 +1,37 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINODOWNSAMPLER_H
+#define MINODOWNSAMPLER_H
+
+#include <QImage>
+
+// Box (area) filter used to bring a supersampled rendering to an output's native resolution.
+// Each destination pixel is the average of the source pixels it covers: sizes don't need to be multiples,
+// so one rendering can feed outputs of different resolutions.
+class MinoDownsampler
+{
+public:
+    // source: RGB32 (or ARGB32 premultiplied) image, destination: RGB32 image sized to the output
+    static void downsample(const QImage *source, QImage *destination);
+};
+
+#endif // MINODOWNSAMPLER_H
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoframedumper.h"
+
+#include <QDebug>
+#include <QBuffer>
+#include <QFileInfo>
+#include <QThreadPool>
+#if QT_VERSION >= 0x050000
+#include <QtConcurrent/QtConcurrentRun>
+#else
+#include <QtConcurrentRun>
+#endif
+
+#include "minodownsampler.h"
+
+MinoFrameDumper::MinoFrameDumper() :
+    _dumping(false),
+    _format(Raw),
+    _frameCount(0),
+    _written(0)
+{
+}
+
+MinoFrameDumper::Format MinoFrameDumper::formatForFileName(const QString &fileName)
+{
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    if(suffix == "png")
+        return Png;
+    if(suffix == "y4m")
+        return Y4m;
+    return Raw;
+}
+
+bool MinoFrameDumper::start(const QString &fileName, const QSize &size, const Format format, const qreal fps)
+{
+    stop();
+    if(!size.isValid())
+        return false;
+
+    _fileName = fileName;
+    _size = size;
+    _format = format;
+    _frameCount = 0;
+    _written = 0;
+
+    if(_format == Png)
+    {
+        // Frame number goes in file name
+        if(!_fileName.contains("%1"))
+        {
+            const QFileInfo info(_fileName);
+            _fileName = info.path() + "/" + info.completeBaseName() + "-%1." + info.suffix();
+        }
+    }
+    else
+    {
+        _file.setFileName(fileName);
+        if(!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qDebug() << Q_FUNC_INFO
+                     << "unable to open" << fileName;
+            return false;
+        }
+        if(_format == Y4m)
+        {
+            // Frame rate is a ratio: keep 3 decimals
+            const QString header = QString("YUV4MPEG2 W%1 H%2 F%3:1000 Ip A1:1 C444\n")
+                    .arg(size.width()).arg(size.height()).arg(qRound(fps * 1000.0));
+            _file.write(header.toLatin1());
+        }
+    }
+    _dumping = true;
+    return true;
+}
+
+void MinoFrameDumper::stop()
+{
+    if(!_dumping)
+        return;
+    _dumping = false;
+    writePending(true);
+    if(_file.isOpen())
+        _file.close();
+    qDebug() << Q_FUNC_INFO
+             << _frameCount << "frames" << _size << "written to" << _fileName;
+}
+
+void MinoFrameDumper::dump(const QImage *image)
+{
+    if(!_dumping || !image)
+        return;
+
+    // Frame is copied: rendering is reused for next frame while this one is encoded
+    QImage frame;
+    if(image->size() != _size)
+    {
+        frame = QImage(_size, QImage::Format_RGB32);
+        MinoDownsampler::downsample(image, &frame);
+    }
+    else
+    {
+        frame = image->copy();
+    }
+    _pending.append(QtConcurrent::run(&MinoFrameDumper::encode, frame, _format));
+    _frameCount++;
+
+    // Keep a bounded number of frames in flight
+    writePending(_pending.count() > (QThreadPool::globalInstance()->maxThreadCount() * 2));
+}
+
+void MinoFrameDumper::writePending(const bool wait)
+{
+    // Wait for oldest frame only when asked to (queue full or end of dump)
+    bool waitForFirst = wait;
+    while(!_pending.isEmpty() && (waitForFirst || _pending.first().isFinished()))
+    {
+        const QByteArray data = _pending.takeFirst().result();
+        if(_format == Png)
+        {
+            QFile file(_fileName.arg(_written, 6, 10, QChar('0')));
+            if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || (file.write(data) != data.size()))
+            {
+                qDebug() << Q_FUNC_INFO
+                         << "unable to write" << file.fileName();
+            }
+        }
+        else
+        {
+            _file.write(data);
+        }
+        _written++;
+        // At end of dump, every frame is waited for
+        waitForFirst = wait && !_dumping;
+    }
+}
+
+QByteArray MinoFrameDumper::encode(const QImage frame, const Format format)
+{
+    const int width = frame.width();
+    const int height = frame.height();
+    QByteArray data;
+    switch(format)
+    {
+    case Raw:
+    {
+        data.resize(width * height * 3);
+        char *rgb = data.data();
+        for(int y=0; y<height; y++)
+        {
+            const QRgb *pixels = reinterpret_cast<const QRgb*>(frame.constScanLine(y));
+            for(int x=0; x<width; x++)
+            {
+                *rgb++ = qRed(pixels[x]);
+                *rgb++ = qGreen(pixels[x]);
+                *rgb++ = qBlue(pixels[x]);
+            }
+        }
+    }
+        break;
+    case Png:
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        frame.save(&buffer, "PNG");
+    }
+        break;
+    case Y4m:
+    {
+        // Planes follow frame header: Y, then U, then V (BT.601, studio range)
+        static const char header[] = "FRAME\n";
+        const int planeSize = width * height;
+        data.resize(sizeof(header) - 1 + (planeSize * 3));
+        memcpy(data.data(), header, sizeof(header) - 1);
+        uchar *yPlane = reinterpret_cast<uchar*>(data.data()) + sizeof(header) - 1;
+        uchar *uPlane = yPlane + planeSize;
+        uchar *vPlane = uPlane + planeSize;
+        for(int y=0; y<height; y++)
+        {
+            const QRgb *pixels = reinterpret_cast<const QRgb*>(frame.constScanLine(y));
+            for(int x=0; x<width; x++)
+            {
+                const int r = qRed(pixels[x]);
+                const int g = qGreen(pixels[x]);
+                const int b = qBlue(pixels[x]);
+                *yPlane++ = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+                *uPlane++ = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+                *vPlane++ = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+            }
+        }
+    }
+        break;
+    }
+    return data;
+}
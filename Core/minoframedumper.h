@@ -0,0 +1,77 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOFRAMEDUMPER_H
+#define MINOFRAMEDUMPER_H
+
+#include <QFile>
+#include <QFuture>
+#include <QImage>
+#include <QList>
+#include <QSize>
+
+// Writes every frame sent to the LED matrix to disk, at matrix size (renderings of another size are downsampled):
+//  - Raw: RGB (3 bytes per pixel, rows from top), frames are concatenated in one file,
+//  - Png: one file per frame, "%1" in file name is replaced by frame number (or appended before extension),
+//  - Y4m: YUV4MPEG2 stream (4:4:4, BT.601), readable by ffmpeg and most video players.
+// Frames are encoded on QThreadPool (all cores), then written in order.
+class MinoFrameDumper
+{
+public:
+    enum Format { Raw, Png, Y4m };
+
+    // Singleton accessor
+    static MinoFrameDumper *dumper() { static MinoFrameDumper *dumper = new MinoFrameDumper(); return dumper; }
+
+    // fps is only used by Y4m header
+    bool start(const QString &fileName, const QSize &size, const Format format = Raw, const qreal fps = 25.0);
+    // Waits for pending frames
+    void stop();
+    bool isDumping() const { return _dumping; }
+
+    void dump(const QImage *image);
+
+    int frameCount() const { return _frameCount; }
+    QSize size() const { return _size; }
+    Format format() const { return _format; }
+
+    // Format from file extension (.png, .y4m, anything else is raw)
+    static Format formatForFileName(const QString &fileName);
+
+private:
+    MinoFrameDumper();
+
+    bool _dumping;
+    QFile _file;
+    QString _fileName;
+    QSize _size;
+    Format _format;
+    int _frameCount;
+
+    // Encoded frames, in frame order
+    QList< QFuture<QByteArray> > _pending;
+    int _written;
+    void writePending(const bool wait);
+
+    static QByteArray encode(const QImage frame, const Format format);
+};
+
+#endif // MINOFRAMEDUMPER_H
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoglyphatlas.h"
+
+#include <QPainter>
+#include <QFontMetrics>
+
+// Built-in pixel font geometry
+#define PIXEL_FONT_FIRST_CHAR 0x20
+#define PIXEL_FONT_LAST_CHAR 0x7E
+#define PIXEL_FONT_WIDTH 5
+#define PIXEL_FONT_HEIGHT 7
+#define PIXEL_FONT_SPACING 1
+
+// 5x7 font for printable ASCII characters: one byte per column, LSB on top
+static const unsigned char pixelFont5x7[][PIXEL_FONT_WIDTH] = {
+    {0x00,0x00,0x00,0x00,0x00}, // ' '
+    {0x00,0x00,0x5F,0x00,0x00}, // !
+    {0x00,0x07,0x00,0x07,0x00}, // "
+    {0x14,0x7F,0x14,0x7F,0x14}, // #
+    {0x24,0x2A,0x7F,0x2A,0x12}, // $
+    {0x23,0x13,0x08,0x64,0x62}, // %
+    {0x36,0x49,0x55,0x22,0x50}, // &
+    {0x00,0x05,0x03,0x00,0x00}, // '
+    {0x00,0x1C,0x22,0x41,0x00}, // (
+    {0x00,0x41,0x22,0x1C,0x00}, // )
+    {0x08,0x2A,0x1C,0x2A,0x08}, // *
+    {0x08,0x08,0x3E,0x08,0x08}, // +
+    {0x00,0x50,0x30,0x00,0x00}, // ,
+    {0x08,0x08,0x08,0x08,0x08}, // -
+    {0x00,0x60,0x60,0x00,0x00}, // .
+    {0x20,0x10,0x08,0x04,0x02}, // /
+    {0x3E,0x51,0x49,0x45,0x3E}, // 0
+    {0x00,0x42,0x7F,0x40,0x00}, // 1
+    {0x42,0x61,0x51,0x49,0x46}, // 2
+    {0x21,0x41,0x45,0x4B,0x31}, // 3
+    {0x18,0x14,0x12,0x7F,0x10}, // 4
+    {0x27,0x45,0x45,0x45,0x39}, // 5
+    {0x3C,0x4A,0x49,0x49,0x30}, // 6
+    {0x01,0x71,0x09,0x05,0x03}, // 7
+    {0x36,0x49,0x49,0x49,0x36}, // 8
+    {0x06,0x49,0x49,0x29,0x1E}, // 9
+    {0x00,0x36,0x36,0x00,0x00}, // :
+    {0x00,0x56,0x36,0x00,0x00}, // ;
+    {0x08,0x14,0x22,0x41,0x00}, // <
+    {0x14,0x14,0x14,0x14,0x14}, // =
+    {0x00,0x41,0x22,0x14,0x08}, // >
+    {0x02,0x01,0x51,0x09,0x06}, // ?
+    {0x32,0x49,0x79,0x41,0x3E}, // @
+    {0x7E,0x11,0x11,0x11,0x7E}, // A
+    {0x7F,0x49,0x49,0x49,0x36}, // B
+    {0x3E,0x41,0x41,0x41,0x22}, // C
+    {0x7F,0x41,0x41,0x22,0x1C}, // D
+    {0x7F,0x49,0x49,0x49,0x41}, // E
+    {0x7F,0x09,0x09,0x01,0x01}, // F
+    {0x3E,0x41,0x41,0x51,0x32}, // G
+    {0x7F,0x08,0x08,0x08,0x7F}, // H
+    {0x00,0x41,0x7F,0x41,0x00}, // I
+    {0x20,0x40,0x41,0x3F,0x01}, // J
+    {0x7F,0x08,0x14,0x22,0x41}, // K
+    {0x7F,0x40,0x40,0x40,0x40}, // L
+    {0x7F,0x02,0x04,0x02,0x7F}, // M
+    {0x7F,0x04,0x08,0x10,0x7F}, // N
+    {0x3E,0x41,0x41,0x41,0x3E}, // O
+    {0x7F,0x09,0x09,0x09,0x06}, // P
+    {0x3E,0x41,0x51,0x21,0x5E}, // Q
+    {0x7F,0x09,0x19,0x29,0x46}, // R
+    {0x46,0x49,0x49,0x49,0x31}, // S
+    {0x01,0x01,0x7F,0x01,0x01}, // T
+    {0x3F,0x40,0x40,0x40,0x3F}, // U
+    {0x1F,0x20,0x40,0x20,0x1F}, // V
+    {0x7F,0x20,0x18,0x20,0x7F}, // W
+    {0x63,0x14,0x08,0x14,0x63}, // X
+    {0x03,0x04,0x78,0x04,0x03}, // Y
+    {0x61,0x51,0x49,0x45,0x43}, // Z
+    {0x00,0x7F,0x41,0x41,0x00}, // [
+    {0x02,0x04,0x08,0x10,0x20}, // '\'
+    {0x00,0x41,0x41,0x7F,0x00}, // ]
+    {0x04,0x02,0x01,0x02,0x04}, // ^
+    {0x40,0x40,0x40,0x40,0x40}, // _
+    {0x00,0x01,0x02,0x04,0x00}, // `
+    {0x20,0x54,0x54,0x54,0x78}, // a
+    {0x7F,0x48,0x44,0x44,0x38}, // b
+    {0x38,0x44,0x44,0x44,0x20}, // c
+    {0x38,0x44,0x44,0x48,0x7F}, // d
+    {0x38,0x54,0x54,0x54,0x18}, // e
+    {0x08,0x7E,0x09,0x01,0x02}, // f
+    {0x08,0x54,0x54,0x54,0x3C}, // g
+    {0x7F,0x08,0x04,0x04,0x78}, // h
+    {0x00,0x44,0x7D,0x40,0x00}, // i
+    {0x20,0x40,0x44,0x3D,0x00}, // j
+    {0x7F,0x10,0x28,0x44,0x00}, // k
+    {0x00,0x41,0x7F,0x40,0x00}, // l
+    {0x7C,0x04,0x18,0x04,0x78}, // m
+    {0x7C,0x08,0x04,0x04,0x78}, // n
+    {0x38,0x44,0x44,0x44,0x38}, // o
+    {0x7C,0x14,0x14,0x14,0x08}, // p
+    {0x08,0x14,0x14,0x18,0x7C}, // q
+    {0x7C,0x08,0x04,0x04,0x08}, // r
+    {0x48,0x54,0x54,0x54,0x20}, // s
+    {0x04,0x3F,0x44,0x40,0x20}, // t
+    {0x3C,0x40,0x40,0x20,0x7C}, // u
+    {0x1C,0x20,0x40,0x20,0x1C}, // v
+    {0x3C,0x40,0x30,0x40,0x3C}, // w
+    {0x44,0x28,0x10,0x28,0x44}, // x
+    {0x0C,0x50,0x50,0x50,0x3C}, // y
+    {0x44,0x64,0x54,0x4C,0x44}, // z
+    {0x00,0x08,0x36,0x41,0x00}, // {
+    {0x00,0x00,0x7F,0x00,0x00}, // |
+    {0x00,0x41,0x36,0x08,0x00}, // }
+    {0x08,0x04,0x08,0x10,0x08}  // ~
+};
+
+MinoGlyphAtlas::MinoGlyphAtlas() :
+    _cache(64*1024) // in pixels
+{
+    buildPixelAtlas();
+}
+
+void MinoGlyphAtlas::buildPixelAtlas()
+{
+    const int glyphCount = PIXEL_FONT_LAST_CHAR - PIXEL_FONT_FIRST_CHAR + 1;
+    _pixelAtlas = QImage(glyphCount*PIXEL_FONT_WIDTH, PIXEL_FONT_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+    _pixelAtlas.fill(0);
+    for(int g=0; g<glyphCount; g++)
+    {
+        for(int x=0; x<PIXEL_FONT_WIDTH; x++)
+        {
+            const unsigned char column = pixelFont5x7[g][x];
+            for(int y=0; y<PIXEL_FONT_HEIGHT; y++)
+            {
+                if(column & (1<<y))
+                    _pixelAtlas.setPixel((g*PIXEL_FONT_WIDTH)+x, y, 0xffffffff);
+            }
+        }
+    }
+}
+
+QRect MinoGlyphAtlas::pixelGlyphRect(const QChar &c) const
+{
+    int code = c.unicode();
+    if((code < PIXEL_FONT_FIRST_CHAR) || (code > PIXEL_FONT_LAST_CHAR))
+        code = '?';
+    return QRect((code-PIXEL_FONT_FIRST_CHAR)*PIXEL_FONT_WIDTH, 0, PIXEL_FONT_WIDTH, PIXEL_FONT_HEIGHT);
+}
+
+QImage MinoGlyphAtlas::pixelText(const QString &text, const QColor &color)
+{
+    const QString key = QString("pixel5x7|%1|%2").arg(color.rgba()).arg(text);
+    if(QImage *cached = _cache.object(key))
+        return *cached;
+
+    const int advance = PIXEL_FONT_WIDTH + PIXEL_FONT_SPACING;
+    QImage *image = new QImage(qMax(1, (text.length()*advance)-PIXEL_FONT_SPACING), PIXEL_FONT_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+    image->fill(0);
+
+    QPainter painter(image);
+    for(int i=0; i<text.length(); i++)
+    {
+        painter.drawImage(QPoint(i*advance, 0), _pixelAtlas, pixelGlyphRect(text.at(i)));
+    }
+    // Colorize white glyphs
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(image->rect(), color);
+    painter.end();
+
+    // Take a reference before insertion: cache may drop the image right away
+    const QImage result = *image;
+    _cache.insert(key, image, image->width()*image->height());
+    return result;
+}
+
+QImage MinoGlyphAtlas::text(const QString &text, const QFont &font, const QColor &color)
+{
+    const QString key = QString("%1|%2|%3").arg(font.key()).arg(color.rgba()).arg(text);
+    if(QImage *cached = _cache.object(key))
+        return *cached;
+
+    const QFontMetrics fm(font);
+    QImage *image = new QImage(qMax(1, fm.width(text)), fm.height(), QImage::Format_ARGB32_Premultiplied);
+    image->fill(0);
+
+    QPainter painter(image);
+    painter.setFont(font);
+    painter.setPen(color);
+    painter.drawText(0, fm.ascent(), text);
+    painter.end();
+
+    // Take a reference before insertion: cache may drop the image right away
+    const QImage result = *image;
+    _cache.insert(key, image, image->width()*image->height());
+    return result;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOGLYPHATLAS_H
+#define MINOGLYPHATLAS_H
+
+#include <QCache>
+#include <QImage>
+#include <QFont>
+#include <QColor>
+#include <QRect>
+
+// Shared text rasterizer: rendered strings are cached per (text, font, color),
+// so displaying an already seen text costs a blit instead of a layout pass.
+// A built-in 5x7 pixel font (designed for low-resolution LED matrices) is
+// rendered from a glyph atlas.
+class MinoGlyphAtlas
+{
+public:
+    // Returns text rasterized with a system font (antialiased)
+    QImage text(const QString &text, const QFont &font, const QColor &color);
+
+    // Returns text rasterized with built-in 5x7 pixel font (crisp)
+    QImage pixelText(const QString &text, const QColor &color);
+
+    // Singleton accessor
+    static MinoGlyphAtlas *atlas() { static MinoGlyphAtlas *atlas = new MinoGlyphAtlas(); return atlas; }
+
+private:
+    MinoGlyphAtlas();
+
+    // Rasterized strings, cost is pixels count
+    QCache<QString, QImage> _cache;
+
+    // Pixel font glyphs, white on transparent, stored side by side
+    QImage _pixelAtlas;
+    QRect pixelGlyphRect(const QChar &c) const;
+    void buildPixelAtlas();
+};
+
+#endif // MINOGLYPHATLAS_H
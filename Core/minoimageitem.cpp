@@ -0,0 +1,69 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoimageitem.h"
+
+#include <QPainter>
+
+MinoImageItem::MinoImageItem(const QSize &size, QGraphicsItem *parent) :
+    QGraphicsItem(parent),
+    _rect(QPointF(0,0), size)
+{
+}
+
+void MinoImageItem::setSize(const QSize &size)
+{
+    if(_rect.size() != size)
+    {
+        prepareGeometryChange();
+        _rect.setSize(size);
+    }
+}
+
+void MinoImageItem::setImage(const QImage &image)
+{
+    _image = image;
+    update();
+}
+
+void MinoImageItem::setBuffer(const uchar *data, const QSize &size, const int bytesPerLine, const QImage::Format format)
+{
+    _image = QImage(data, size.width(), size.height(), bytesPerLine, format);
+    update();
+}
+
+void MinoImageItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    (void)option;
+    (void)widget;
+
+    if(_image.isNull())
+        return;
+
+    if(_image.size() == _rect.size().toSize())
+    {
+        painter->drawImage(_rect.topLeft(), _image);
+    }
+    else
+    {
+        painter->drawImage(_rect, _image);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOIMAGEITEM_H
+#define MINOIMAGEITEM_H
+
+#include <QGraphicsItem>
+#include <QImage>
+
+// Graphics item compositing a QImage (or a raw pixels buffer) straight into the scene.
+// Image is stretched to item's size when they differ.
+class MinoImageItem : public QGraphicsItem
+{
+public:
+    explicit MinoImageItem(const QSize &size, QGraphicsItem *parent = 0);
+
+    QRectF boundingRect() const { return _rect; }
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
+
+    QSize size() const { return _rect.size().toSize(); }
+    void setSize(const QSize &size);
+
+    // Image is implicitly shared: no pixels are copied here
+    void setImage(const QImage &image);
+
+    // Wrap an external buffer without any copy
+    // Warning: buffer must remain valid until another image or buffer is set
+    void setBuffer(const uchar *data, const QSize &size, const int bytesPerLine, const QImage::Format format);
+
+    // Allow in-place rendering: caller is responsible to call update() once done
+    QImage *image() { return &_image; }
+
+private:
+    QRectF _rect;
+    QImage _image;
+};
+
+#endif // MINOIMAGEITEM_H
@@ -1,12 +1,14 @@
 #include "minoinstrumentedanimation.h"
 #include "minotor.h"
 #include "minoanimationgroup.h"
+#include "minoprogram.h"
 
 #include <QDebug>
 
 MinoInstrumentedAnimation::MinoInstrumentedAnimation(QObject *parent) :
     MinoAnimation(parent),
     _alive(false),
+    _notePhase(0.0),
     _itemCreationRequested(0)
 {
     _midiChannel = new MinoPropertyMidiChannel(this);
@@ -93,12 +95,12 @@ void MinoInstrumentedAnimation::processItemCreation(const uint uppqn)
     _itemCreationRequested = 0;
 }
 
-void MinoInstrumentedAnimation::handleNoteChange(int interface, quint8 channel, quint8 note, bool on, quint8 value)
+void MinoInstrumentedAnimation::handleNoteChange(int interface, quint8 channel, quint8 note, bool on, quint8 value, qint64 timestamp)
 {
     (void)interface;
     if((_midiChannel->channel()) && (channel==_midiChannel->channel()-1))
     {
-        _noteEvents.append(MinoInstrumentNoteEvent(note, on, value));
+        _noteEvents.append(MinoInstrumentNoteEvent(note, on, value, timestamp));
 
         setAlive(true);
         MinoAnimationGroup* mag = qobject_cast<MinoAnimationGroup*>(parent());
@@ -109,18 +111,31 @@ void MinoInstrumentedAnimation::handleNoteChange(int interface, quint8 channel,
 
 void MinoInstrumentedAnimation::processNotesEvents(const uint uppqn)
 {
-    foreach(MinoInstrumentNoteEvent ne, _noteEvents)
+    if(!_noteEvents.isEmpty())
     {
-        if(ne.on())
+        Minotor *minotor = Minotor::minotor();
+        const MinoClockSource *clockSource = minotor->clockSource();
+        const qint64 pulseTimestamp = clockSource->pulseTimestamp();
+        const qreal pulseDuration = clockSource->pulseDuration();
+        const bool onAir = group() && (group()->program() == minotor->master()->program());
+        foreach(MinoInstrumentNoteEvent ne, _noteEvents)
         {
-            _startNote(uppqn, ne.note(), ne.value());
-            _pendingNotes.append(ne.note());
-        } else {
-            _stopNote(uppqn, ne.note());
-            _pendingNotes.removeAt(_pendingNotes.indexOf(ne.note()));
+            // Frames are rendered every 2 pulses: a note is at most 2 pulses late
+            _notePhase = qBound((qreal)0.0, (qreal)(pulseTimestamp - ne.timestamp()) / pulseDuration, (qreal)2.0);
+            if(ne.on())
+            {
+                _startNote(uppqn, ne.note(), ne.value());
+                _pendingNotes.append(ne.note());
+                if(onAir)
+                    minotor->notifyNoteOnAir(ne.timestamp());
+            } else {
+                _stopNote(uppqn, ne.note());
+                _pendingNotes.removeAt(_pendingNotes.indexOf(ne.note()));
+            }
         }
+        _notePhase = 0.0;
+        _noteEvents.clear();
     }
-    _noteEvents.clear();
     foreach(int note, _pendingNotes)
     {
         _processPendingNote(uppqn, note);
@@ -10,19 +10,22 @@
 class MinoInstrumentNoteEvent
 {
 public:
-    explicit MinoInstrumentNoteEvent(quint8 note, bool on, quint8 value):
+    explicit MinoInstrumentNoteEvent(quint8 note, bool on, quint8 value, qint64 timestamp):
             _note(note),
             _on(on),
-            _value(value) {}
+            _value(value),
+            _timestamp(timestamp) {}
 
     quint8 note() const { return _note; }
     bool on() const { return _on; }
     quint8 value() const { return _value; }
+    qint64 timestamp() const { return _timestamp; }
 
 private:
     quint8 _note;
     bool _on;
     quint8 _value;
+    qint64 _timestamp;
 
 };
 
@@ -43,7 +46,7 @@ public:
 signals:
     
 public slots:
-    void handleNoteChange(int interface, quint8 channel, quint8 note, bool on, quint8 value);
+    void handleNoteChange(int interface, quint8 channel, quint8 note, bool on, quint8 value, qint64 timestamp);
 
 protected:
     // Status
@@ -58,6 +61,9 @@ protected:
     virtual void _stopNote(const uint uppqn, const quint8 note) { (void)note; (void)uppqn; }
     virtual void _processPendingNote(const uint uppqn, const quint8 note) { (void)note; (void)uppqn; }
     void processNotesEvents(const uint uppqn);
+    // Pulses elapsed since the note being processed was played (0.0 outside of note processing):
+    // items created from _startNote() should be given this phase to be placed at sub-frame position
+    qreal _notePhase;
 
     // Item creation (ie. by user interface)
     int _itemCreationRequested;
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoitempainter.h"
+
+#include <QGraphicsItem>
+#include <QGraphicsEffect>
+#include <QGraphicsScene>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+
+static bool zValueLessThan(const QGraphicsItem *item1, const QGraphicsItem *item2)
+{
+    return item1->zValue() < item2->zValue();
+}
+
+void MinoItemPainter::paint(QPainter *painter, QGraphicsItem *root)
+{
+    paint(painter, root, root);
+}
+
+bool MinoItemPainter::isVisible(const QGraphicsItem *root)
+{
+    if(!root->isVisible() || (root->opacity() <= 0.0))
+        return false;
+    // Groups only paint their children
+    const bool hasContents = !(root->flags() & QGraphicsItem::ItemHasNoContents) && (root->type() != QGraphicsItemGroup::Type);
+    if(hasContents && (root->effectiveOpacity() > 0.0))
+        return true;
+    foreach(const QGraphicsItem *child, root->childItems())
+    {
+        if(isVisible(child))
+            return true;
+    }
+    return false;
+}
+
+bool MinoItemPainter::needsScene(const QGraphicsItem *item)
+{
+    if(!item->scene())
+        return false;
+    if(item->flags() & QGraphicsItem::ItemClipsChildrenToShape)
+        return true;
+    const QGraphicsEffect *effect = item->graphicsEffect();
+    return effect && effect->isEnabled();
+}
+
+void MinoItemPainter::paintThroughScene(QPainter *painter, QGraphicsItem *root, QGraphicsItem *item)
+{
+    QGraphicsScene *scene = item->scene();
+
+    // Scene renders all its items: everything out of item's branch is hidden meanwhile
+    QList<QGraphicsItem*> hiddenItems;
+    QList<QGraphicsItem*> topLevelItems;
+    foreach(QGraphicsItem *sceneItem, scene->items())
+    {
+        if(!sceneItem->parentItem())
+            topLevelItems.append(sceneItem);
+    }
+    for(QGraphicsItem *branch = item; branch; branch = branch->parentItem())
+    {
+        const QList<QGraphicsItem*> siblings = branch->parentItem() ? branch->parentItem()->childItems() : topLevelItems;
+        foreach(QGraphicsItem *sibling, siblings)
+        {
+            if((sibling != branch) && sibling->isVisible())
+            {
+                sibling->setVisible(false);
+                hiddenItems.append(sibling);
+            }
+        }
+    }
+
+    // Same source and target: scene coordinates are only mapped to root ones
+    const QRectF sceneRect = scene->sceneRect();
+    painter->save();
+    painter->setTransform(root->sceneTransform().inverted(), true);
+    scene->render(painter, sceneRect, sceneRect, Qt::IgnoreAspectRatio);
+    painter->restore();
+
+    foreach(QGraphicsItem *hiddenItem, hiddenItems)
+    {
+        hiddenItem->setVisible(true);
+    }
+}
+
+void MinoItemPainter::paint(QPainter *painter, QGraphicsItem *root, QGraphicsItem *item)
+{
+    if(!item->isVisible())
+        return;
+
+    if(needsScene(item))
+    {
+        paintThroughScene(painter, root, item);
+        return;
+    }
+
+    QList<QGraphicsItem*> children = item->childItems();
+    qStableSort(children.begin(), children.end(), zValueLessThan);
+
+    // Children stacked behind parent are painted first
+    foreach(QGraphicsItem *child, children)
+    {
+        if((child->zValue() < 0) || (child->flags() & QGraphicsItem::ItemStacksBehindParent))
+            paint(painter, root, child);
+    }
+
+    if(!(item->flags() & QGraphicsItem::ItemHasNoContents))
+    {
+        QStyleOptionGraphicsItem option;
+        option.exposedRect = item->boundingRect();
+        painter->save();
+        painter->setTransform(item->itemTransform(root), true);
+        painter->setOpacity(item->effectiveOpacity());
+        item->paint(painter, &option, NULL);
+        painter->restore();
+    }
+
+    foreach(QGraphicsItem *child, children)
+    {
+        if((child->zValue() >= 0) && !(child->flags() & QGraphicsItem::ItemStacksBehindParent))
+            paint(painter, root, child);
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOITEMPAINTER_H
+#define MINOITEMPAINTER_H
+
+class QGraphicsItem;
+class QPainter;
+
+// Paints a QGraphicsItem tree (in root item coordinates) without going through its scene:
+// items are neither moved nor rendered along with other items of the scene.
+// Exception: items with a graphics effect (ie. blur) or clipping their children are rendered by
+// their scene, alone, since only QGraphicsScene applies effects and clipping.
+class MinoItemPainter
+{
+public:
+    static void paint(QPainter *painter, QGraphicsItem *root);
+    // True if painting root would change at least one pixel (visible item with contents and opacity)
+    static bool isVisible(const QGraphicsItem *root);
+
+private:
+    static void paint(QPainter *painter, QGraphicsItem *root, QGraphicsItem *item);
+    static bool needsScene(const QGraphicsItem *item);
+    static void paintThroughScene(QPainter *painter, QGraphicsItem *root, QGraphicsItem *item);
+};
+
+#endif // MINOITEMPAINTER_H
@@ -23,12 +23,19 @@
 #include "minotor.h"
 #include "minoanimationgroup.h"
 #include "minopropertyreal.h"
+#include "midicontrollablelist.h"
 
 #include <QDebug>
 
+#include <string.h>
+
 MinoMaster::MinoMaster(Minotor *minotor):
     QObject(),
+    _minotor(minotor),
     _program(NULL),
+    _nextProgram(NULL),
+    _transitionStart(-1),
+    _transitionProgress(0.0),
     _shifted(false)
 {
     minotor->scene()->addItem(&_itemGroup);
@@ -39,6 +46,23 @@ MinoMaster::MinoMaster(Minotor *minotor):
     mpBrightness->setLabel("Brightness");
     connect(mpBrightness, SIGNAL(valueChanged(qreal)), this, SLOT(setBrightness(qreal)));
 
+    _transition = new MidiControllableList(this);
+    _transition->setObjectName("master-transition");
+    _transition->setLabel("Transition");
+    _transition->addItem("cut", Cut);
+    _transition->addItem("fade", Crossfade);
+    _transition->addItem("wipe", Wipe);
+    _transition->setCurrentItemFromString("cut");
+
+    _transitionLength = new MidiControllableList(this);
+    _transitionLength->setObjectName("master-transition-length");
+    _transitionLength->setLabel("Beats");
+    _transitionLength->addItem("1", 24);
+    _transitionLength->addItem("2", 48);
+    _transitionLength->addItem("4", 96);
+    _transitionLength->addItem("8", 192);
+    _transitionLength->setCurrentItemFromString("1");
+
     _midiMapper = new MinoMasterMidiMapper(this);
 }
 
@@ -53,10 +77,127 @@ MinoMaster::~MinoMaster()
 
 void MinoMaster::setBrightness(qreal value)
 {
-    _itemGroup.setOpacity(value);
+    // Brightness is applied by LED matrix output stage (ie. no scene compositing cost)
+    _minotor->ledMatrix()->colorPipeline()->setBrightness(value);
+}
+
+MinoMaster::Transition MinoMaster::transition() const
+{
+    return (Transition)(int)_transition->currentItem()->real();
 }
 
 void MinoMaster::setProgram(MinoProgram *program)
+{
+    if(_nextProgram)
+    {
+        // Abort running transition: requested program will start from current one
+        disconnect(_nextProgram, SIGNAL(destroyed()), this, SLOT(clearNextProgram()));
+        clearNextProgram();
+    }
+
+    if((_program == program) || !_program || !program
+            || (transition() == Cut)
+            || !_minotor->clockSource()->isEnabled())
+    {
+        changeProgram(program);
+        return;
+    }
+
+    // Transition will start on next beat
+    _nextProgram = program;
+    connect(_nextProgram, SIGNAL(destroyed()), this, SLOT(clearNextProgram()));
+}
+
+void MinoMaster::clearNextProgram()
+{
+    _nextProgram = NULL;
+    _transitionStart = -1;
+    _transitionProgress = 0.0;
+}
+
+void MinoMaster::updateTransition(const unsigned int uppqn, const unsigned int ppqn)
+{
+    if(!_nextProgram)
+        return;
+
+    if(_transitionStart < 0)
+    {
+        if(ppqn != 0)
+            return;
+        _transitionStart = uppqn;
+    }
+
+    const qreal length = _transitionLength->currentItem()->real();
+    _transitionProgress = (qreal)(uppqn - _transitionStart) / length;
+    if(_transitionProgress >= 1.0)
+    {
+        MinoProgram *program = _nextProgram;
+        disconnect(_nextProgram, SIGNAL(destroyed()), this, SLOT(clearNextProgram()));
+        clearNextProgram();
+        changeProgram(program);
+    }
+}
+
+// Blend two RGB32 pixels: 2 channels are processed per multiplication (8 bits of headroom per channel)
+// weight is in range [0-256]
+static inline quint32 lerpPixel(const quint32 from, const quint32 to, const quint32 weight)
+{
+    const quint32 inverse = 256 - weight;
+    const quint32 rb = ((((from & 0x00ff00ff) * inverse) + ((to & 0x00ff00ff) * weight)) >> 8) & 0x00ff00ff;
+    const quint32 ag = ((((from >> 8) & 0x00ff00ff) * inverse) + (((to >> 8) & 0x00ff00ff) * weight)) & 0xff00ff00;
+    return rb | ag;
+}
+
+const QImage *MinoMaster::rendering()
+{
+    if(!_program)
+        return NULL;
+    const QImage *from = _program->rendering();
+    if(!isInTransition())
+        return from;
+    const QImage *to = _nextProgram->rendering();
+    if(from->size() != to->size())
+        return from;
+
+    if((_transitionImage.size() != from->size()) || (_transitionImage.format() != QImage::Format_RGB32))
+        _transitionImage = QImage(from->size(), QImage::Format_RGB32);
+
+    const int width = from->width();
+    const int height = from->height();
+    switch(transition())
+    {
+    case Crossfade:
+    {
+        const quint32 weight = qBound(0, (int)(_transitionProgress * 256.0), 256);
+        for(int y=0; y<height; y++)
+        {
+            const quint32 *fromLine = reinterpret_cast<const quint32*>(from->constScanLine(y));
+            const quint32 *toLine = reinterpret_cast<const quint32*>(to->constScanLine(y));
+            quint32 *line = reinterpret_cast<quint32*>(_transitionImage.scanLine(y));
+            for(int x=0; x<width; x++)
+                line[x] = lerpPixel(fromLine[x], toLine[x], weight);
+        }
+    }
+        break;
+    case Wipe:
+    {
+        // Next program comes from the left
+        const int split = qBound(0, (int)(_transitionProgress * width), width);
+        for(int y=0; y<height; y++)
+        {
+            quint32 *line = reinterpret_cast<quint32*>(_transitionImage.scanLine(y));
+            memcpy(line, to->constScanLine(y), split * sizeof(quint32));
+            memcpy(line + split, reinterpret_cast<const quint32*>(from->constScanLine(y)) + split, (width - split) * sizeof(quint32));
+        }
+    }
+        break;
+    case Cut:
+        return from;
+    }
+    return &_transitionImage;
+}
+
+void MinoMaster::changeProgram(MinoProgram *program)
 {
     if (_program != program)
     {
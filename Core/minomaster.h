@@ -25,6 +25,7 @@
 #include "minomastermidimapper.h"
 
 class Minotor;
+class MidiControllableList;
 
 class MinoMaster : public QObject
 {
@@ -33,15 +34,37 @@ public:
     explicit MinoMaster(Minotor *minotor);
     ~MinoMaster();
 
+    // Program goes on-air using current transition (Cut is immediate, others start on next beat)
     void setProgram(MinoProgram *program);
     MinoProgram *program() { return _program; }
 
+    // Transitions
+    enum Transition { Cut, Crossfade, Wipe };
+    Transition transition() const;
+    // Program going on-air (NULL if no transition is pending or running)
+    MinoProgram *nextProgram() { return _nextProgram; }
+    bool isInTransition() const { return _nextProgram && (_transitionStart >= 0); }
+    // Starts, advances and completes transitions (called by Minotor on each clock pulse)
+    void updateTransition(const unsigned int uppqn, const unsigned int ppqn);
+    // Image to send to output: program rendering or blend of current and next programs renderings
+    const QImage *rendering();
+
     void setViewportRange(const int min, const int max);
 
 private:
+    Minotor *_minotor;
     MinoProgram *_program;
     MinoMasterMidiMapper *_midiMapper;
 
+    // Transition
+    MidiControllableList *_transition;
+    MidiControllableList *_transitionLength; // in ppqn
+    MinoProgram *_nextProgram;
+    qint64 _transitionStart; // uppqn, -1 until next beat
+    qreal _transitionProgress;
+    QImage _transitionImage;
+    void changeProgram(MinoProgram *program);
+
     bool _shifted;
     QGraphicsItemGroup _itemGroup;
 
@@ -53,6 +76,8 @@ signals:
 public slots:
     void setBrightness(qreal value);
     void clear();
+private slots:
+    void clearNextProgram();
 };
 
 #endif // MINOMASTER_H
@@ -50,56 +50,73 @@ MinoMasterMidiMapper::MinoMasterMidiMapper(MinoMaster *parent) :
 #define MINOMASTERMIDIMAPPER_TRACKS_MAX 40
 #define MINOMASTERMIDIMAPPER_KNOBS_MAX 4
 
+// Role names are formatted once per process, then shared by register/clear/update
+class MinoMasterMidiMapperRoles
+{
+public:
+    static const MinoMasterMidiMapperRoles &roles() { static MinoMasterMidiMapperRoles roles; return roles; }
+
+    QString animation[MINOMASTERMIDIMAPPER_TRACKS_MAX];
+    QString animationShift[MINOMASTERMIDIMAPPER_TRACKS_MAX];
+    QString animationCreate[MINOMASTERMIDIMAPPER_TRACKS_MAX];
+    QString controls[MINOMASTERMIDIMAPPER_TRACKS_MAX][MINOMASTERMIDIMAPPER_KNOBS_MAX];
+
+private:
+    MinoMasterMidiMapperRoles()
+    {
+        for (int i=0; i<MINOMASTERMIDIMAPPER_TRACKS_MAX; i++)
+        {
+            const QString index = QString::number(i);
+            animation[i] = "MASTER_ANIMATION_" + index;
+            animationShift[i] = "MASTER_ANIMATION_SHIFT_" + index;
+            animationCreate[i] = "MASTER_ANIMATION_CREATE_" + index;
+            for(int j=0; j<MINOMASTERMIDIMAPPER_KNOBS_MAX; j++)
+            {
+                controls[i][j] = "MASTER_CONTROLS_" + index + "_" + QString::number(j);
+            }
+        }
+    }
+};
+
 void MinoMasterMidiMapper::registerRoles()
 {
+    const MinoMasterMidiMapperRoles &roles = MinoMasterMidiMapperRoles::roles();
+
     // Note: triggers have to be registered before Midi device can map it.
     // So, the question is "how many roles should we register for master ?"
     for (int i=0; i<MINOMASTERMIDIMAPPER_TRACKS_MAX; i++)
     {
-        QString role = QString("MASTER_ANIMATION_%1").arg(i);
-        QString description = QString("Toggle master's animation #%1").arg(i);
-        MidiMapper::registerTrigger(role, description, MinoRole::Trigger);
-
-        role = QString("MASTER_ANIMATION_SHIFT_%1").arg(i);
-        description = QString("Activate master's animation #%1").arg(i);
-        MidiMapper::registerTrigger(role, description, MinoRole::Hold);
-
-        role = QString("MASTER_ANIMATION_CREATE_%1").arg(i);
-        description = QString("Create item on master's animation #%1").arg(i);
-        MidiMapper::registerTrigger(role, description, MinoRole::Trigger);
+        const QString index = QString::number(i);
+        MidiMapper::registerTrigger(roles.animation[i], "Toggle master's animation #" + index, MinoRole::Trigger);
+        MidiMapper::registerTrigger(roles.animationShift[i], "Activate master's animation #" + index, MinoRole::Hold);
+        MidiMapper::registerTrigger(roles.animationCreate[i], "Create item on master's animation #" + index, MinoRole::Trigger);
     }
 
-    QSize sHardMappedArea(MINOMASTERMIDIMAPPER_TRACKS_MAX, MINOMASTERMIDIMAPPER_KNOBS_MAX);
-    for (int x=0; x<sHardMappedArea.width(); ++x)
+    for (int x=0; x<MINOMASTERMIDIMAPPER_TRACKS_MAX; ++x)
     {
-        for(int y=0; y<sHardMappedArea.height(); ++y)
+        for(int y=0; y<MINOMASTERMIDIMAPPER_KNOBS_MAX; ++y)
         {
-            const QString role = QString("MASTER_CONTROLS_%1_%2").arg(x).arg(y);
-            const QString description = QString("Change control at %1,%2").arg(x).arg(y);
-            MidiMapper::registerControl(role, description);
+            MidiMapper::registerControl(roles.controls[x][y], QString("Change control at %1,%2").arg(x).arg(y));
         }
     }
 }
 
 void MinoMasterMidiMapper::clearRoles()
 {
+    const MinoMasterMidiMapperRoles &roles = MinoMasterMidiMapperRoles::roles();
+
     for (int i=0; i<MINOMASTERMIDIMAPPER_TRACKS_MAX; i++)
     {
-        QString role = QString("MASTER_ANIMATION_%1").arg(i);
-        MidiMapper::connectTrigger(role, NULL, NULL, NULL, NULL, false, true);
-        role = QString("MASTER_ANIMATION_SHIFT_%1").arg(i);
-        MidiMapper::connectTrigger(role, NULL, NULL, NULL, NULL, false, true);
-        role = QString("MASTER_ANIMATION_CREATE_%1").arg(i);
-        MidiMapper::connectTrigger(role, NULL, NULL, NULL, NULL, false, true);
+        MidiMapper::connectTrigger(roles.animation[i], NULL, NULL, NULL, NULL, false, true);
+        MidiMapper::connectTrigger(roles.animationShift[i], NULL, NULL, NULL, NULL, false, true);
+        MidiMapper::connectTrigger(roles.animationCreate[i], NULL, NULL, NULL, NULL, false, true);
     }
 
-    QSize sHardMappedArea(MINOMASTERMIDIMAPPER_TRACKS_MAX, MINOMASTERMIDIMAPPER_KNOBS_MAX);
-    for (int x=0; x<sHardMappedArea.width(); ++x)
+    for (int x=0; x<MINOMASTERMIDIMAPPER_TRACKS_MAX; ++x)
     {
-        for(int y=0; y<sHardMappedArea.height(); ++y)
+        for(int y=0; y<MINOMASTERMIDIMAPPER_KNOBS_MAX; ++y)
         {
-            const QString role = QString("MASTER_CONTROLS_%1_%2").arg(x).arg(y);
-            MidiMapper::connectControl(role, NULL, NULL, true);
+            MidiMapper::connectControl(roles.controls[x][y], NULL, NULL, true);
         }
     }
 }
@@ -249,6 +266,8 @@ void MinoMasterMidiMapper::decrementVirtualPageOffset()
 
 void MinoMasterMidiMapper::updateMap()
 {
+    const MinoMasterMidiMapperRoles &roles = MinoMasterMidiMapperRoles::roles();
+
     clearRoles();
 
     if (_program)
@@ -257,23 +276,18 @@ void MinoMasterMidiMapper::updateMap()
         _virtualPageOffset = qMax(0, _virtualPageOffset);
         const int range_max = qMin(tracks, _virtualPageOffset+_virtualPageWidth);
 
-        qDebug() << Q_FUNC_INFO
-                 << "offset:" << _virtualPageOffset
-                 << "available tracks:" << tracks
-                 << "virtual page size:" << _virtualPageWidth
-                 << "range:" << _virtualPageOffset << "," << range_max;
-
         for(int i=_virtualPageOffset; i<range_max; ++i)
         {
             const int role_index = i - _virtualPageOffset;
             MinoAnimationGroup *group = _program->animationGroups().at(i);
-            QString role = QString("MASTER_ANIMATION_%1").arg(role_index);
-            MidiMapper::connectTrigger(role, group, SLOT(setEnabled(bool)), NULL, NULL, true, true);
-            role = QString("MASTER_ANIMATION_SHIFT_%1").arg(role_index);
-            MinoTrigger* mt = MidiMapper::connectTrigger(role, group, SLOT(toggle()), group, SIGNAL(enabledChanged(bool)), false, true);
+            if(role_index >= MINOMASTERMIDIMAPPER_TRACKS_MAX)
+            {
+                break;
+            }
+            MidiMapper::connectTrigger(roles.animation[role_index], group, SLOT(setEnabled(bool)), NULL, NULL, true, true);
+            MinoTrigger* mt = MidiMapper::connectTrigger(roles.animationShift[role_index], group, SLOT(toggle()), group, SIGNAL(enabledChanged(bool)), false, true);
             mt->setFeedback(group->enabled());
-            role = QString("MASTER_ANIMATION_CREATE_%1").arg(role_index);
-            MidiMapper::connectTrigger(role, group, SLOT(createItem()), NULL, NULL, false, true);
+            MidiMapper::connectTrigger(roles.animationCreate[role_index], group, SLOT(createItem()), NULL, NULL, false, true);
 
             int id = 0;
             foreach(MinoAnimation *animation, group->animations())
@@ -283,12 +297,11 @@ void MinoMasterMidiMapper::updateMap()
                 {
                     if(mcp.at(j)->isPreferred())
                     {
-                        if (id >= _knobsPerTrack)
+                        if ((id >= _knobsPerTrack) || (id >= MINOMASTERMIDIMAPPER_KNOBS_MAX))
                         {
                             break;
                         }
-                        const QString role = QString("MASTER_CONTROLS_%1_%2").arg(role_index).arg(id);
-                        MidiMapper::connectControl(role, mcp.at(j), SLOT(setValueFromMidi(quint8)), true);
+                        MidiMapper::connectControl(roles.controls[role_index][id], mcp.at(j), SLOT(setValueFromMidi(quint8)), true);
                         id++;
                     }
                 }
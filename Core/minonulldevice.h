@@ -0,0 +1,44 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINONULLDEVICE_H
+#define MINONULLDEVICE_H
+
+#include <QIODevice>
+
+// Output sink discarding everything (used in place of serial port, ie. by benchmarks)
+class MinoNullDevice : public QIODevice
+{
+public:
+    explicit MinoNullDevice(QObject *parent = 0) : QIODevice(parent), _bytesWritten(0) { }
+
+    bool isSequential() const { return true; }
+    qint64 totalBytesWritten() const { return _bytesWritten; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) { (void)data; (void)maxSize; return -1; }
+    qint64 writeData(const char *data, qint64 size) { (void)data; _bytesWritten += size; return size; }
+
+private:
+    qint64 _bytesWritten;
+};
+
+#endif // MINONULLDEVICE_H
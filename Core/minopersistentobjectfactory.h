@@ -45,7 +45,9 @@ public:
     template<typename T>
     static void registerAnimationClass()
     {
-        animationModels().append( T::getDescription() );
+        // Descriptions load pictures: they are only built when first requested
+        animationDescriptors().append( &T::getDescription );
+        animationModels().clear();
         constructors().insert( T::staticMetaObject.className(), &constructorHelper<T> );
     }
 
@@ -59,11 +61,19 @@ public:
 
     static QList<MinoAnimationDescription> availableAnimationModels()
     {
-        return animationModels();
+        QList<MinoAnimationDescription>& models = animationModels();
+        if ( models.count() != animationDescriptors().count() )
+        {
+            models.clear();
+            foreach ( MinoAnimationDescriptor descriptor, animationDescriptors() )
+                models.append( (*descriptor)() );
+        }
+        return models;
     }
 
 private:
     typedef MinoPersistentObject* (*MinoPersistentObjectConstructor)( QObject *object );
+    typedef const MinoAnimationDescription (*MinoAnimationDescriptor)();
 
     template<typename T>
     static MinoPersistentObject* constructorHelper( QObject *object )
@@ -82,6 +92,12 @@ private:
         static QList<MinoAnimationDescription> _animationModels;
         return _animationModels;
     }
+
+    static QList<MinoAnimationDescriptor>& animationDescriptors()
+    {
+        static QList<MinoAnimationDescriptor> _animationDescriptors;
+        return _animationDescriptors;
+    }
 };
 
 #endif // MINOPERSISTENTOBJECTFACTORY_H
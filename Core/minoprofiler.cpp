@@ -0,0 +1,228 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoprofiler.h"
+
+#include <QMutexLocker>
+
+#include "minotracerecorder.h"
+
+// Samples kept per key to compute statistics
+#define MINOPROFILER_WINDOW_SIZE 256
+
+bool MinoProfilerRing::push(const Sample &sample)
+{
+    const int head = _head.fetchAndAddOrdered(0);
+    const int next = (head + 1) & (Size - 1);
+    if(next == _tail.fetchAndAddOrdered(0))
+        return false;
+    _samples[head] = sample;
+    _head.fetchAndStoreOrdered(next);
+    return true;
+}
+
+bool MinoProfilerRing::pop(Sample *sample)
+{
+    const int tail = _tail.fetchAndAddOrdered(0);
+    if(tail == _head.fetchAndAddOrdered(0))
+        return false;
+    *sample = _samples[tail];
+    _tail.fetchAndStoreOrdered((tail + 1) & (Size - 1));
+    return true;
+}
+
+MinoProfiler::MinoProfiler() :
+    _enabled(true),
+    _deadline(0),
+    _dropped(0)
+{
+    clock();
+}
+
+QElapsedTimer &MinoProfiler::clock()
+{
+    static QElapsedTimer timer;
+    if(!timer.isValid())
+        timer.start();
+    return timer;
+}
+
+int MinoProfiler::key(const QString &name)
+{
+    QMutexLocker locker(&_keysMutex);
+    QHash<QString, int>::const_iterator it = _keys.constFind(name);
+    if(it != _keys.constEnd())
+        return it.value();
+    const int id = _keyNames.count();
+    _keyNames.append(name);
+    _keys.insert(name, id);
+    return id;
+}
+
+QString MinoProfiler::keyName(const int key)
+{
+    QMutexLocker locker(&_keysMutex);
+    return _keyNames.value(key);
+}
+
+MinoProfilerRing *MinoProfiler::ring()
+{
+    if(!_ring.hasLocalData())
+    {
+        RingHandle *handle = new RingHandle;
+        handle->ring = new MinoProfilerRing();
+        _ring.setLocalData(handle);
+        QMutexLocker locker(&_ringsMutex);
+        _rings.append(handle->ring);
+    }
+    return _ring.localData()->ring;
+}
+
+void MinoProfiler::record(const int key, const qint64 start, const qint64 duration)
+{
+    MinoProfilerRing::Sample sample;
+    sample.key = key;
+    sample.start = start;
+    sample.duration = duration;
+    sample.deadline = _deadline;
+    if(!ring()->push(sample))
+        _dropped.fetchAndAddRelaxed(1);
+
+    MinoTraceRecorder *recorder = MinoTraceRecorder::recorder();
+    if(recorder->isRecording())
+        recorder->span(key, start, duration);
+}
+
+void MinoProfiler::drain()
+{
+    QList<MinoProfilerRing*> rings;
+    {
+        QMutexLocker locker(&_ringsMutex);
+        rings = _rings;
+    }
+    MinoProfilerRing::Sample sample;
+    foreach(MinoProfilerRing *ring, rings)
+    {
+        while(ring->pop(&sample))
+        {
+            Window &window = _windows[sample.key];
+            if(window.samples.isEmpty())
+                window.samples.resize(MINOPROFILER_WINDOW_SIZE);
+            window.samples[window.pos] = sample.duration;
+            window.pos = (window.pos + 1) % MINOPROFILER_WINDOW_SIZE;
+            window.count++;
+            if(sample.deadline && (sample.duration > sample.deadline))
+                window.misses++;
+        }
+    }
+}
+
+void MinoProfiler::collect()
+{
+    QMutexLocker locker(&_statsMutex);
+    drain();
+}
+
+QList<MinoProfilerStats> MinoProfiler::stats()
+{
+    QMutexLocker locker(&_statsMutex);
+    drain();
+
+    QList<MinoProfilerStats> result;
+    QHash<int, Window>::const_iterator it;
+    for(it = _windows.constBegin(); it != _windows.constEnd(); ++it)
+    {
+        const Window &window = it.value();
+        const int size = qMin(window.count, (int)MINOPROFILER_WINDOW_SIZE);
+        if(!size)
+            continue;
+        QVector<qint64> sorted = window.samples.mid(0, size);
+        qSort(sorted);
+        qint64 sum = 0;
+        foreach(const qint64 duration, sorted)
+            sum += duration;
+
+        MinoProfilerStats stats;
+        stats.name = keyName(it.key());
+        stats.count = window.count;
+        stats.min = sorted.first();
+        stats.max = sorted.last();
+        stats.avg = sum / size;
+        stats.p99 = sorted.at(qMin(size-1, (size*99)/100));
+        stats.deadlineMisses = window.misses;
+        result.append(stats);
+    }
+    return result;
+}
+
+void MinoProfiler::removeWindow(const int key)
+{
+    QMutexLocker locker(&_statsMutex);
+    // Pending samples would create the window again
+    drain();
+    _windows.remove(key);
+}
+
+QString MinoProfiler::statsToJson()
+{
+    QStringList entries;
+    foreach(const MinoProfilerStats &stats, this->stats())
+    {
+        QString name = stats.name;
+        name.replace('\\', "\\\\").replace('"', "\\\"");
+        entries.append(QString("{\"name\": \"%1\", \"count\": %2, \"min_ns\": %3, \"avg_ns\": %4, \"p99_ns\": %5, \"max_ns\": %6, \"deadline_misses\": %7}")
+                       .arg(name).arg(stats.count)
+                       .arg(stats.min).arg(stats.avg).arg(stats.p99).arg(stats.max)
+                       .arg(stats.deadlineMisses));
+    }
+    return "[" + entries.join(", ") + "]";
+}
+
+void MinoProfiler::mark(const QString &milestone)
+{
+    QMutexLocker locker(&_milestonesMutex);
+    _milestones.append(qMakePair(milestone, now()));
+}
+
+QString MinoProfiler::startupReport()
+{
+    QMutexLocker locker(&_milestonesMutex);
+    QStringList lines;
+    qint64 previous = 0;
+    for(int i=0; i<_milestones.count(); i++)
+    {
+        const qint64 timestamp = _milestones.at(i).second;
+        lines.append(QString("%1 ms (+%2 ms) %3")
+                     .arg((qreal)timestamp / 1000000.0, 8, 'f', 1)
+                     .arg((qreal)(timestamp - previous) / 1000000.0, 0, 'f', 1)
+                     .arg(_milestones.at(i).first));
+        previous = timestamp;
+    }
+    return lines.join("\n");
+}
+
+void MinoProfiler::reset()
+{
+    QMutexLocker locker(&_statsMutex);
+    drain();
+    _windows.clear();
+    _dropped.fetchAndStoreRelaxed(0);
+}
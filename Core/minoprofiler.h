@@ -0,0 +1,174 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOPROFILER_H
+#define MINOPROFILER_H
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QStringList>
+#include <QThreadStorage>
+#include <QVector>
+
+// Statistics of a profiled stage, computed over last samples
+class MinoProfilerStats
+{
+public:
+    MinoProfilerStats() : count(0), min(0), avg(0), p99(0), max(0), deadlineMisses(0) { }
+
+    QString name;
+    int count;          // samples since last reset
+    qint64 min;         // ns
+    qint64 avg;         // ns
+    qint64 p99;         // ns
+    qint64 max;         // ns
+    int deadlineMisses; // samples longer than frame deadline since last reset
+};
+
+// Timing samples written by a single thread, read by the aggregating thread
+class MinoProfilerRing
+{
+public:
+    struct Sample {
+        int key;
+        qint64 start;
+        qint64 duration;
+        qint64 deadline;
+    };
+    enum { Size = 4096 }; // Must be a power of 2
+
+    MinoProfilerRing() : _head(0), _tail(0) { }
+
+    // Producer side (owner thread): returns false when ring is full (sample dropped)
+    bool push(const Sample &sample);
+    // Consumer side (aggregator)
+    bool pop(Sample *sample);
+
+private:
+    Sample _samples[Size];
+    QAtomicInt _head;
+    QAtomicInt _tail;
+};
+
+class MinoProfiler
+{
+public:
+    // Singleton accessor
+    static MinoProfiler *profiler() { static MinoProfiler *profiler = new MinoProfiler(); return profiler; }
+
+    // Monotonic clock, in nanoseconds
+    static qint64 now() { return clock().nsecsElapsed(); }
+
+    bool isEnabled() const { return _enabled; }
+    void setEnabled(const bool on) { _enabled = on; }
+
+    // Frame deadline: samples longer than this are counted as misses
+    qint64 deadline() const { return _deadline; }
+    void setDeadline(const qint64 ns) { _deadline = ns; }
+
+    // Stage names are interned once: hot path only handles integers
+    int key(const QString &name);
+    QString keyName(const int key);
+
+    // Record a sample (lock-free, may be called from any thread)
+    void record(const int key, const qint64 start, const qint64 duration);
+
+    // Move pending samples of all threads to statistics windows: called once per frame,
+    // so rings never fill up even when nobody queries statistics
+    void collect();
+
+    // Query API: drain pending samples and compute statistics
+    QList<MinoProfilerStats> stats();
+    // Forget statistics of a stage which is not recorded anymore (ie. destroyed or renamed animation)
+    void removeWindow(const int key);
+    // Same as stats() serialized as a JSON array
+    QString statsToJson();
+    void reset();
+
+    // Number of samples lost because a ring was full
+    int droppedSamples() { return _dropped.fetchAndAddRelaxed(0); }
+
+    // Startup milestones (time elapsed since profiler's clock creation)
+    void mark(const QString &milestone);
+    QString startupReport();
+
+private:
+    MinoProfiler();
+    static QElapsedTimer &clock();
+
+    bool _enabled;
+    qint64 _deadline;
+    QAtomicInt _dropped;
+
+    // Startup
+    QMutex _milestonesMutex;
+    QList<QPair<QString, qint64> > _milestones;
+
+    // Keys
+    QMutex _keysMutex;
+    QHash<QString, int> _keys;
+    QStringList _keyNames;
+
+    // Per-thread rings (registered once, never freed while profiler lives)
+    // NOTE: QThreadStorage deletes its data when thread exits, so it only holds a handle
+    struct RingHandle {
+        MinoProfilerRing *ring;
+    };
+    QThreadStorage<RingHandle*> _ring;
+    QMutex _ringsMutex;
+    QList<MinoProfilerRing*> _rings;
+    MinoProfilerRing *ring();
+
+    // Aggregation (consumer side)
+    struct Window {
+        Window() : pos(0), count(0), misses(0) { }
+        QVector<qint64> samples;
+        int pos;
+        int count;
+        int misses;
+    };
+    QMutex _statsMutex;
+    QHash<int, Window> _windows;
+    void drain();
+};
+
+// Record time spent in a C++ scope
+class MinoProfilerScope
+{
+public:
+    explicit MinoProfilerScope(const int key) :
+        _key(key),
+        _start(MinoProfiler::profiler()->isEnabled()?MinoProfiler::now():-1) { }
+    ~MinoProfilerScope()
+    {
+        if(_start >= 0)
+            MinoProfiler::profiler()->record(_key, _start, MinoProfiler::now()-_start);
+    }
+private:
+    int _key;
+    qint64 _start;
+};
+
+#endif // MINOPROFILER_H
@@ -22,13 +22,17 @@
 
 #include "minotor.h"
 #include "minoanimationgroup.h"
+#include "minoprofiler.h"
 
 #include <QBrush>
 #include <QDebug>
 
 MinoProgram::MinoProgram(QObject *parent) :
     MinoPersistentObject(parent),
+    _profilerAnimateKey(-1),
+    _profilerRenderKey(-1),
     _image(NULL),
+    _supersampling(1),
     _onAir(false)
 {
     // Beat factor used for delayed animation launch
@@ -63,10 +67,19 @@ void MinoProgram::setRect(const QRect rect)
 {
     _heightForWidthRatio = (qreal)rect.size().height() / (qreal)rect.size().width();
     if (_image) delete _image;
-    _image = new QImage(rect.size(), QImage::Format_RGB32);
+    _image = new QImage(rect.size() * _supersampling, QImage::Format_RGB32);
     _rect = rect;
 }
 
+void MinoProgram::setSupersampling(const int factor)
+{
+    if((factor < 1) || (factor == _supersampling))
+        return;
+    _supersampling = factor;
+    if(_image)
+        setRect(_rect);
+}
+
 void MinoProgram::setDrawingPos(const QPointF pos)
 {
      _itemGroup.setPos(pos);
@@ -75,6 +88,10 @@ void MinoProgram::setDrawingPos(const QPointF pos)
 
 void MinoProgram::animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn)
 {
+    if(_profilerAnimateKey == -1)
+        _profilerAnimateKey = MinoProfiler::profiler()->key(QString("program %1 animate").arg(_id));
+    MinoProfilerScope profilerScope(_profilerAnimateKey);
+
     // Set position to origin
     _itemGroup.setPos(0,0);
 
@@ -110,19 +127,55 @@ void MinoProgram::animate(const unsigned int uppqn, const unsigned int gppqn, co
 
     // Reset position to the affected one_itemGroup
     _itemGroup.setPos(_drawingPos);
+}
+
+void MinoProgram::render()
+{
+    if(_profilerRenderKey == -1)
+        _profilerRenderKey = MinoProfiler::profiler()->key(QString("program %1 render").arg(_id));
+    MinoProfilerScope profilerScope(_profilerRenderKey);
 
     // Set background
     _image->fill(Qt::black);
 
-    // Render the scene at previously saved view rect
-    QPainter painter(_image);
-    //painter.setRenderHint(QPainter::Antialiasing);
-    _scene->render(&painter, QRectF(_image->rect()), QRectF(_drawingPos, _rect.size()), Qt::IgnoreAspectRatio);
+    // Occlusion: groups below topmost opaque one can't be seen (they are still animated)
+    int firstVisibleGroup = 0;
+    for(int i=_animationGroups.count()-1; i>=0; i--)
+    {
+        MinoAnimationGroup *group = _animationGroups.at(i);
+        if(group->isAlive() && group->isOpaque())
+        {
+            firstVisibleGroup = i;
+            break;
+        }
+    }
+
+    // Each group is rendered in its own layer (reused when group did not change),
+    // then layers are blended in groups order
+    QList<MinoCompositor::Layer> layers;
+    for(int i=firstVisibleGroup; i<_animationGroups.count(); i++)
+    {
+        MinoAnimationGroup *group = _animationGroups.at(i);
+        if(group->isAlive() && group->isVisible())
+            layers.append(MinoCompositor::Layer(group->layer(_image->size(), _supersampling), (MinoCompositor::BlendMode)group->blendMode()));
+    }
+    MinoCompositor::composite(_image, layers);
 
     // Let's connected object to know the program's animation is done
     emit animated();
 }
 
+void MinoProgram::waitForFrames()
+{
+    foreach(MinoAnimationGroup *group, _animationGroups)
+    {
+        foreach(MinoAnimation *animation, group->animations())
+        {
+            animation->waitForFrames();
+        }
+    }
+}
+
 void MinoProgram::destroyGroup(QObject *group)
 {
     MinoAnimationGroup * mag = static_cast<MinoAnimationGroup*>(group);
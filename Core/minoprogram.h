@@ -26,6 +26,7 @@
 #include <QGraphicsScene>
 #include <QGraphicsItemGroup>
 #include <QRect>
+#include <QAtomicInt>
 
 #include "minoanimation.h"
 #include "minoanimationgroup.h"
@@ -52,13 +53,20 @@ public:
     QGraphicsScene *scene() const { return _scene; }
     QGraphicsItemGroup *itemGroup() { return &_itemGroup; }
     MinoAnimationGroupList animationGroups() const { return _animationGroups; }
+    // Note: rendering size is rect size multiplied by supersampling factor
     const QImage *rendering() const { return _image; }
+    int supersampling() const { return _supersampling; }
     int id() const { return _id; }
 
     // Selection
     bool isSelected() { return true; }
     bool isOnAir() { return _onAir; }
 
+    // Viewers: visible widgets displaying rendering (program is rendered for them even when LEDs are blacked out)
+    void addViewer() { _viewers.ref(); }
+    void removeViewer() { _viewers.deref(); }
+    bool isViewed() { return _viewers.fetchAndAddOrdered(0) > 0; }
+
     // Function is compute height with a given width (very useful for UI)
     int heightForWidth( int width ) const { return (qreal)width * _heightForWidthRatio; }
 
@@ -73,8 +81,10 @@ public:
 
 protected:
     // At end of object creation, Minotor will set ID and drawing rect
-    void setId(const int id) { _id = id; }
+    void setId(const int id) { _id = id; _profilerAnimateKey = -1; _profilerRenderKey = -1; }
     void setRect(const QRect rect);
+    // Rendering is done at rect size * factor (drawing rect stays in scene coordinates)
+    void setSupersampling(const int factor);
     void setDrawingPos(const QPointF pos);
 
     // Acceded by MinoMaster
@@ -86,6 +96,10 @@ private:
     // ID
     int _id;
 
+    // Keys used to report timings to MinoProfiler
+    int _profilerAnimateKey;
+    int _profilerRenderKey;
+
     // Scene
     QGraphicsScene *_scene;
 
@@ -95,6 +109,7 @@ private:
 
     // QImage to store rendering
     QImage *_image;
+    int _supersampling;
 
     // Image ratio
     qreal _heightForWidthRatio;
@@ -104,6 +119,9 @@ private:
 
     bool _onAir;
 
+    // Viewers are (un)registered from GUI thread and checked from clock's one
+    QAtomicInt _viewers;
+
     QString _label;
 
 protected:
@@ -135,7 +153,12 @@ signals:
     void animationGroupAdded(QObject * group);
 
 public:
+    // Animate groups (ie. objects creation/destruction/moves)
     void animate(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn);
+    // Render scene's program area to rendering() image
+    void render();
+    // Blocks until every animation finished its asynchronous setup (see MinoAnimation::waitForFrames)
+    void waitForFrames();
 
 private slots:
     void destroyGroup(QObject *group);
@@ -24,7 +24,12 @@
 
 MinoProgramBank::MinoProgramBank(QObject *parent) :
     MinoPersistentObject(parent),
-    _programSelectorPos(-1)
+    _programSelectorPos(-1),
+    _visible(true)
+{
+}
+
+void MinoProgramBank::registerTriggers()
 {
     MidiMapper::registerTrigger("BANK_NEXT", "Move selector to next program", this, SLOT(programSelectorNext()), NULL, NULL, MinoRole::Trigger, true);
     MidiMapper::registerTrigger("BANK_PREVIOUS", "Move selector to previous program", this, SLOT(programSelectorPrevious()), NULL, NULL, MinoRole::Trigger, true);
@@ -43,15 +48,17 @@ void MinoProgramBank::addProgram(MinoProgram *program)
     // Program ID starts at 1
     program->setId(id+1);
 
-    LedMatrix *matrix = minotor()->ledMatrix();
-    // Inform program about matrix size (used by animations)
-    program->setRect(matrix->rect());
+    // Inform program about rendering size (the one used by animations)
+    const QRect rect = minotor()->displayRect();
+    program->setSupersampling(minotor()->supersampling());
+    program->setRect(rect);
     // Drawing rect
     // On the scene, the program have a dedicated area to display/draw animations
     // This area left one "screen" before and one "screen" areas to prevent from collisions
     // Note: Developer of animations should take care to not collide: its objects should never be larger than one screen-size in all directions (up, down, left, right, diagonals)
-    QPointF pos = QPointF(matrix->size().width()*3, matrix->size().height() + ((matrix->size().height()*3) * id));
+    QPointF pos = QPointF(rect.width()*3, rect.height() + ((rect.height()*3) * id));
     program->setDrawingPos(pos);
+    program->itemGroup()->setVisible(_visible);
     connect(program,SIGNAL(destroyed(QObject*)),this,SLOT(destroyProgram(QObject*)));
     emit programAdded(program);
 }
@@ -65,6 +72,23 @@ MinoProgramBank::~MinoProgramBank()
     _programs.clear();
 }
 
+void MinoProgramBank::setVisible(const bool on)
+{
+    _visible = on;
+    foreach(MinoProgram *program, _programs)
+    {
+        program->itemGroup()->setVisible(on);
+    }
+}
+
+void MinoProgramBank::setSupersampling(const int factor)
+{
+    foreach(MinoProgram *program, _programs)
+    {
+        program->setSupersampling(factor);
+    }
+}
+
 Minotor* MinoProgramBank::minotor()
 {
     Minotor* minotor =  qobject_cast<Minotor*>(parent());
@@ -34,6 +34,13 @@ public:
     // Program
     void addProgram(MinoProgram *program);
     QList<MinoProgram*> programs() { return _programs; }
+    // Show/hide programs' graphics items (staged banks are kept out of the rendering)
+    bool isVisible() const { return _visible; }
+    void setVisible(const bool on);
+    // Apply renderer supersampling factor to every program
+    void setSupersampling(const int factor);
+    // Take over BANK_* triggers (only on-air bank owns them: staged banks must not steal them)
+    void registerTriggers();
     ~MinoProgramBank();
     Minotor *minotor();
 
@@ -45,6 +52,7 @@ private:
     // Programs
     QList<MinoProgram*> _programs;
     int _programSelectorPos;
+    bool _visible;
     
 public slots:
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoprogrambankloader.h"
+
+#include <QDebug>
+#include <QTimer>
+#if QT_VERSION >= 0x050000
+#include <QtConcurrent/QtConcurrentRun>
+#else
+#include <QtConcurrentRun>
+#endif
+
+#include "minotor.h"
+
+MinoProgramBankLoader::MinoProgramBankLoader(Minotor *minotor) :
+    QObject(minotor),
+    _minotor(minotor),
+    _bank(NULL)
+{
+    connect(&_opener, SIGNAL(finished()), this, SLOT(opened()));
+}
+
+MinoProgramBankLoader::~MinoProgramBankLoader()
+{
+    if(_opener.isRunning())
+    {
+        _opener.waitForFinished();
+        delete _opener.result();
+    }
+    delete _bank;
+}
+
+MinoBinaryBank *MinoProgramBankLoader::openBank(const QString &fileName)
+{
+    MinoBinaryBank *bank = new MinoBinaryBank(fileName);
+    if(!bank->open())
+    {
+        delete bank;
+        return NULL;
+    }
+    return bank;
+}
+
+MinoProgramBankLoader::LoadResult MinoProgramBankLoader::load(const QString &fileName)
+{
+    if(isLoading())
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "a program bank is already being loaded";
+        return Busy;
+    }
+    if(!MinoBinaryBank::isBinaryFile(fileName))
+    {
+        return NotBinary;
+    }
+    _opener.setFuture(QtConcurrent::run(&MinoProgramBankLoader::openBank, fileName));
+    return Loading;
+}
+
+void MinoProgramBankLoader::opened()
+{
+    _bank = _opener.result();
+    if(!_bank)
+    {
+        finish(false);
+        return;
+    }
+
+    // Locate bank object
+    int bankIndex = -1;
+    foreach(const int root, _bank->roots())
+    {
+        if(_bank->className(root) == QString("MinoProgramBank"))
+        {
+            bankIndex = root;
+            break;
+        }
+    }
+    if(bankIndex == -1)
+    {
+        qDebug() << Q_FUNC_INFO
+                 << _bank->fileName() << "doesn't contain any program bank";
+        finish(false);
+        return;
+    }
+
+    // Staging bank stays hidden until it goes on-air
+    _programBank = new MinoProgramBank(_minotor);
+    _programBank->setVisible(false);
+    for(int i=0; i<_bank->propertyCount(bankIndex); i++)
+    {
+        _minotor->writeProperty(_programBank, _bank->propertyName(bankIndex, i), _bank->propertyValue(bankIndex, i));
+    }
+
+    // First program will be on-air: instantiate it now, others will follow
+    _pendingPrograms = _bank->children(bankIndex);
+    if(!_pendingPrograms.isEmpty())
+    {
+        _minotor->loadObject(_bank, _pendingPrograms.takeFirst(), _programBank);
+    }
+    _minotor->queueProgramBank(_programBank);
+
+    QTimer::singleShot(0, this, SLOT(materializeNext()));
+}
+
+void MinoProgramBankLoader::materializeNext()
+{
+    if(!_programBank)
+    {
+        // Bank has been replaced before being fully loaded
+        finish(false);
+        return;
+    }
+    if(_pendingPrograms.isEmpty())
+    {
+        finish(true);
+        return;
+    }
+    _minotor->loadObject(_bank, _pendingPrograms.takeFirst(), _programBank);
+    QTimer::singleShot(0, this, SLOT(materializeNext()));
+}
+
+void MinoProgramBankLoader::finish(const bool success)
+{
+    delete _bank;
+    _bank = NULL;
+    _programBank = NULL;
+    _pendingPrograms.clear();
+    emit loaded(success);
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOPROGRAMBANKLOADER_H
+#define MINOPROGRAMBANKLOADER_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QPointer>
+
+#include "minobinarybank.h"
+#include "minoprogrambank.h"
+
+class Minotor;
+
+// Load a program bank without stalling rendering:
+//  - file is mapped and validated on a worker thread,
+//  - a hidden staging bank is built with the on-air (first) program only,
+//  - Minotor swaps banks on next beat,
+//  - remaining programs are then instantiated one per event loop iteration.
+// NOTE: QObjects and QGraphicsItems are still created on GUI thread (scene is not thread-safe)
+class MinoProgramBankLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MinoProgramBankLoader(Minotor *minotor);
+    ~MinoProgramBankLoader();
+
+    enum LoadResult {
+        Loading,    // Bank is loaded in background, loaded() will be emitted
+        Busy,       // Another bank is being loaded: nothing done
+        NotBinary   // Missing file or legacy INI format: caller should use Minotor::loadFromFile()
+    };
+    LoadResult load(const QString &fileName);
+    bool isLoading() const { return _bank || _opener.isRunning(); }
+
+signals:
+    void loaded(bool success);
+
+private slots:
+    void opened();
+    void materializeNext();
+
+private:
+    Minotor *_minotor;
+    QFutureWatcher<MinoBinaryBank*> _opener;
+    MinoBinaryBank *_bank;
+    QPointer<MinoProgramBank> _programBank;
+    QList<int> _pendingPrograms;
+
+    static MinoBinaryBank *openBank(const QString &fileName);
+    void finish(const bool success);
+};
+
+#endif // MINOPROGRAMBANKLOADER_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minorandom.h"
+
+#include <QAtomicInt>
+
+// splitmix32: spreads any seed (even 0) over the 128 bits of state
+static quint32 splitmix(quint32 *x)
+{
+    quint32 z = (*x += 0x9e3779b9);
+    z = (z ^ (z >> 16)) * 0x85ebca6b;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35;
+    return z ^ (z >> 16);
+}
+
+void MinoRandom::setSeed(const quint32 seed)
+{
+    _seed = seed;
+    quint32 x = seed;
+    for(int i=0; i<4; i++)
+        _s[i] = splitmix(&x);
+}
+
+void MinoRandom::fill(quint32 *values, const int count)
+{
+    for(int i=0; i<count; i++)
+        values[i] = next();
+}
+
+void MinoRandom::fillReal(qreal *values, const int count)
+{
+    for(int i=0; i<count; i++)
+        values[i] = nextReal();
+}
+
+quint32 MinoRandom::nextSeed()
+{
+    static QAtomicInt counter(0);
+    quint32 x = counter.fetchAndAddOrdered(1);
+    return splitmix(&x);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINORANDOM_H
+#define MINORANDOM_H
+
+#include <QtGlobal>
+
+// Small and fast pseudo-random generator (xoshiro128**) owned by each animation:
+// - no shared state, so animations can be rendered from worker threads,
+// - sequence only depends on seed, so replays and benchmarks are reproducible.
+class MinoRandom
+{
+public:
+    explicit MinoRandom(const quint32 seed = 0) { setSeed(seed); }
+
+    quint32 seed() const { return _seed; }
+    // Restart sequence
+    void setSeed(const quint32 seed);
+
+    // Next value in full 32 bits range
+    inline quint32 next()
+    {
+        const quint32 result = rotate(_s[1] * 5, 7) * 9;
+        const quint32 t = _s[1] << 9;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotate(_s[3], 11);
+        return result;
+    }
+    // Next value in range [0-1[
+    inline qreal nextReal() { return (qreal)(next() >> 8) * (1.0 / 16777216.0); }
+    // Next value in range [0-bound[
+    inline quint32 bounded(const quint32 bound) { return (quint32)(((quint64)next() * bound) >> 32); }
+
+    // Batch helpers (ie. density loops)
+    void fill(quint32 *values, const int count);
+    void fillReal(qreal *values, const int count);
+
+    // Seeds given to new animations: a fixed sequence, so a session built the same way renders the same way
+    static quint32 nextSeed();
+
+private:
+    static inline quint32 rotate(const quint32 x, const int k) { return (x << k) | (x >> (32 - k)); }
+
+    quint32 _seed;
+    quint32 _s[4];
+};
+
+#endif // MINORANDOM_H
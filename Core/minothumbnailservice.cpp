@@ -0,0 +1,136 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minothumbnailservice.h"
+
+#include <QPainter>
+
+#if QT_VERSION >= 0x050000
+#include <QtConcurrent/QtConcurrentRun>
+#else
+#include <QtConcurrentRun>
+#endif
+
+#include "minotor.h"
+#include "minoitempainter.h"
+
+// Cache cost unit is kilobyte
+#define MINOTHUMBNAILSERVICE_CACHE_SIZE_KB 4096
+
+MinoThumbnailService::MinoThumbnailService() :
+    QObject(NULL),
+    _cache(MINOTHUMBNAILSERVICE_CACHE_SIZE_KB)
+{
+}
+
+MinoThumbnailService::Key MinoThumbnailService::key(const QObject *owner, const QSize &size)
+{
+    return Key((quintptr)owner, (quint32(size.width()) << 16) | quint32(size.height() & 0xffff));
+}
+
+void MinoThumbnailService::request(QObject *owner, QGraphicsItem *item, const QSize &size)
+{
+    Q_ASSERT(owner);
+    Q_ASSERT(item);
+    if(!size.isValid())
+        return;
+
+    Job job;
+    job.key = key(owner, size);
+    job.owner = owner;
+    job.sceneSize = Minotor::minotor()->displayRect().size();
+    job.size = size;
+    {
+        QPainter painter(&job.picture);
+        MinoItemPainter::paint(&painter, item);
+    }
+
+    connect(owner, SIGNAL(destroyed(QObject*)), this, SLOT(ownerDestroyed(QObject*)), Qt::UniqueConnection);
+
+    // Only one rendering per key at a time: latest snapshot wins
+    foreach(const Job &running, _running)
+    {
+        if(running.key == job.key)
+        {
+            _queued.insert(job.key, job);
+            return;
+        }
+    }
+    start(job);
+}
+
+QImage MinoThumbnailService::thumbnail(const QObject *owner, const QSize &size) const
+{
+    const QImage *image = _cache.object(key(owner, size));
+    return image ? *image : QImage();
+}
+
+void MinoThumbnailService::start(const Job &job)
+{
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(rendered()));
+    _running.insert(watcher, job);
+    watcher->setFuture(QtConcurrent::run(&MinoThumbnailService::rasterize, job.picture, job.sceneSize, job.size));
+}
+
+void MinoThumbnailService::rendered()
+{
+    QFutureWatcher<QImage> *watcher = static_cast<QFutureWatcher<QImage>*>(sender());
+    const Job job = _running.take(watcher);
+    const QImage image = watcher->result();
+    watcher->deleteLater();
+
+    if(job.owner)
+    {
+        _cache.insert(job.key, new QImage(image), qMax(1, image.byteCount() / 1024));
+        emit thumbnailReady(job.owner, image);
+    }
+
+    if(_queued.contains(job.key))
+        start(_queued.take(job.key));
+}
+
+void MinoThumbnailService::ownerDestroyed(QObject *owner)
+{
+    const quintptr address = (quintptr)owner;
+    foreach(const Key &key, _cache.keys())
+    {
+        if(key.first == address)
+            _cache.remove(key);
+    }
+    foreach(const Key &key, _queued.keys())
+    {
+        if(key.first == address)
+            _queued.remove(key);
+    }
+}
+
+QImage MinoThumbnailService::rasterize(const QPicture &picture, const QSize &sceneSize, const QSize &size)
+{
+    QImage scene(sceneSize, QImage::Format_ARGB32_Premultiplied);
+    scene.fill(Qt::black);
+    {
+        QPainter painter(&scene);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.drawPicture(0, 0, picture);
+    }
+    return scene.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
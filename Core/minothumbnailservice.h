@@ -0,0 +1,85 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOTHUMBNAILSERVICE_H
+#define MINOTHUMBNAILSERVICE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QPair>
+#include <QPicture>
+#include <QImage>
+#include <QPointer>
+#include <QFutureWatcher>
+
+class QGraphicsItem;
+
+// Thumbnails of animations and groups, rendered off the live scene:
+//  - item tree is recorded into a QPicture (no item is moved, scene is not rendered),
+//  - picture is rasterized at renderer size then scaled on a worker thread,
+//  - results are kept in a LRU cache (keyed by owner and thumbnail size).
+class MinoThumbnailService : public QObject
+{
+    Q_OBJECT
+public:
+    static MinoThumbnailService *service() { static MinoThumbnailService *service = new MinoThumbnailService(); return service; }
+
+    // Snapshot item (must be called from GUI thread): thumbnailReady() is emitted when rendered
+    void request(QObject *owner, QGraphicsItem *item, const QSize &size);
+
+    // Last rendered thumbnail (null image if none)
+    QImage thumbnail(const QObject *owner, const QSize &size) const;
+
+signals:
+    void thumbnailReady(QObject *owner, const QImage &thumbnail);
+
+private slots:
+    void rendered();
+    void ownerDestroyed(QObject *owner);
+
+private:
+    explicit MinoThumbnailService();
+
+    // Owner address and thumbnail size (width << 16 | height)
+    typedef QPair<quintptr, quint32> Key;
+    static Key key(const QObject *owner, const QSize &size);
+
+    struct Job
+    {
+        Key key;
+        QPointer<QObject> owner;
+        QPicture picture;
+        QSize sceneSize;
+        QSize size;
+    };
+    void start(const Job &job);
+
+    // Rasterization (worker thread)
+    static QImage rasterize(const QPicture &picture, const QSize &sceneSize, const QSize &size);
+
+    QCache<Key, QImage> _cache;
+    QHash<QFutureWatcher<QImage>*, Job> _running;
+    // Latest snapshot requested while a previous one of same key is being rendered
+    QHash<Key, Job> _queued;
+};
+
+#endif // MINOTHUMBNAILSERVICE_H
@@ -22,11 +22,16 @@
 
 #include <QtCore/QDebug>
 
+#include <QFile>
 #include <QGraphicsView>
-#include <QPainter>
 
 #include "minoprogram.h"
 #include "minopersistentobjectfactory.h"
+#include "minoprofiler.h"
+#include "minotracerecorder.h"
+#include "minoframedumper.h"
+#include "minobinarybank.h"
+#include "minoprogrambankloader.h"
 
 // Animations
 #include "minoanimation.h"
@@ -62,6 +67,9 @@
 #include <QDesktopServices>
 #endif
 
+// Clock is considered stalled when no pulse is received during this delay (ie. below 10 bpm)
+#define MINOTOR_STALLED_CLOCK_MS 250
+
 Minotor::Minotor(QObject *parent) :
     QObject(parent)
 {
@@ -77,15 +85,24 @@ Minotor::Minotor(QObject *parent) :
     _rendererSize = _settings->value("renderer/size").toSize();
     if(!_rendererSize.isValid())
         _rendererSize = QSize(24, 16);
+    _supersampling = _settings->value("renderer/supersampling", 1).toInt();
+    if((_supersampling != 2) && (_supersampling != 4))
+        _supersampling = 1;
 
     // Master
     _master = new MinoMaster(this);
 
     // LED Matrix
-    // NOTE: ATM LedMatrix size must be equal to rendering size.
+    // Note: when rendering size differs (ie. supersampling), LedMatrix downsamples it to its own size
     _ledMatrix = new LedMatrix(_rendererSize,_panelSize, _matrixSize, this);
     // Program Bank
     _programBank = new MinoProgramBank(this);
+    _programBank->registerTriggers();
+    _pendingProgramBank = NULL;
+    _ledMatrixBlackedOut = false;
+    _programBankLoader = new MinoProgramBankLoader(this);
+
+    MinoProfiler::profiler()->mark("LED matrix created");
 
     // MIDI interfaces
     _midi = new Midi(this);
@@ -98,6 +115,9 @@ Minotor::Minotor(QObject *parent) :
     _clockSource = new MinoClockSource(this);
     _clockSource->setMidiClockSource(_midi);
     connect(_clockSource, SIGNAL(clock(uint,uint,uint,uint)), this, SLOT(dispatchClock(uint,uint,uint,uint)));
+    _lastClock.start();
+    _pendingProgramBankTimer.setInterval(MINOTOR_STALLED_CLOCK_MS);
+    connect(&_pendingProgramBankTimer, SIGNAL(timeout()), this, SLOT(checkPendingProgramBank()));
 
     // Register animations
     MinoPersistentObjectFactory::registerAnimationClass<MinaFlash>();
@@ -124,6 +144,8 @@ Minotor::Minotor(QObject *parent) :
     MinoPersistentObjectFactory::registerClass<MinoProgram>();
     MinoPersistentObjectFactory::registerClass<MinoAnimationGroup>();
 
+    MinoProfiler::profiler()->mark("core created");
+
 }
 
 void Minotor::loadSettings()
@@ -379,25 +401,94 @@ Minotor::~Minotor()
 
 void Minotor::dispatchClock(const unsigned int uppqn, const unsigned int gppqn, const unsigned int ppqn, const unsigned int qn)
 {
+    _lastClock.start();
+
+    MinoTraceRecorder *recorder = MinoTraceRecorder::recorder();
+    if(recorder->isRecording())
+    {
+        static const int clockKey = MinoProfiler::profiler()->key("clock");
+        recorder->instant(clockKey, MinoProfiler::now(), ppqn);
+    }
+
+    // Staged program bank goes on-air on beat
+    if(_pendingProgramBank && (ppqn == 0))
+    {
+        MinoProgramBank *bank = _pendingProgramBank;
+        _pendingProgramBank = NULL;
+        _pendingProgramBankTimer.stop();
+        changeProgramBank(bank);
+    }
+
     if((ppqn%2) == 0) {
-        // Animate master
+        // Previous frame samples go to statistics windows (HUD and "stats" show last frames)
+        MinoProfiler::profiler()->collect();
+
+        // A frame is expected every 2 ppqn: longer stages miss their deadline
+        static const int profilerKey = MinoProfiler::profiler()->key("frame");
+        MinoProfiler::profiler()->setDeadline((qint64)(60000000000.0 / (_clockSource->bpm() * 12.0)));
+        MinoProfilerScope profilerScope(profilerKey);
+
+        // Animate master (and program going on-air during a transition)
+        _master->updateTransition(uppqn, ppqn);
         if(_master->program())
         {
+            // Nothing can be seen on LEDs when master brightness is off: animation goes on but rasterization
+            // is skipped, unless rendering is displayed by a preview or dumped to file
+            const bool blackedOut = _ledMatrix->colorPipeline()->brightness() <= 0.0;
+            MinoFrameDumper *dumper = MinoFrameDumper::dumper();
+            const bool render = !blackedOut || dumper->isDumping();
             _master->program()->animate(uppqn, gppqn, ppqn, qn);
+            if(render || _master->program()->isViewed())
+                _master->program()->render();
+            if(_master->isInTransition())
+            {
+                _master->nextProgram()->animate(uppqn, gppqn, ppqn, qn);
+                if(render || _master->nextProgram()->isViewed())
+                    _master->nextProgram()->render();
+            }
+
+            // Master rendering blends programs during transitions: it is computed once per frame
+            const QImage *rendering = _master->rendering();
 
-            // Render scene to led matrix
-            _ledMatrix->show(master()->program()->rendering());
+            // Render scene to led matrix (a blacked out matrix only needs one black frame)
+            if(!blackedOut || !_ledMatrixBlackedOut)
+                _ledMatrix->show(rendering);
+            _ledMatrixBlackedOut = blackedOut;
+            if(dumper->isDumping())
+                dumper->dump(rendering);
+
+            // Input-to-output latency: from MIDI message arrival to end of serial write
+            if(!_onAirNotes.isEmpty())
+            {
+                static const int latencyKey = MinoProfiler::profiler()->key("note to output");
+                const qint64 now = MinoProfiler::now();
+                if(MinoProfiler::profiler()->isEnabled())
+                {
+                    foreach(const qint64 timestamp, _onAirNotes)
+                        MinoProfiler::profiler()->record(latencyKey, timestamp, now - timestamp);
+                }
+                _onAirNotes.clear();
+            }
+
+            static bool onAir = false;
+            if(!onAir)
+            {
+                onAir = true;
+                MinoProfiler::profiler()->mark("first frame on air");
+                qDebug() << "Startup timings:\n" << qPrintable(MinoProfiler::profiler()->startupReport());
+            }
         }
 
         QList<MinoProgram*> programs = _programBank->programs();
         for(int i=0; i<programs.count(); i++)
         {
             MinoProgram *program = programs.at(i);
-            if (program!=_master->program())
+            if ((program!=_master->program()) && !(_master->isInTransition() && (program==_master->nextProgram())))
             {
                 if(program->isSelected())
                 {
                     program->animate(uppqn, gppqn, ppqn, qn);
+                    program->render();
                 }
             }
         }
@@ -471,17 +562,28 @@ void Minotor::loadMidiSettings()
 
 void Minotor::loadLedMatrixSettings()
 {
+    LedColorPipeline *pipeline = _ledMatrix->colorPipeline();
+    pipeline->setGamma(_settings->value("output/gamma", 1.0).toReal());
+    pipeline->setWhiteBalance(_settings->value("output/whiteBalance", QColor(Qt::white)).value<QColor>());
+    pipeline->setDithering(_settings->value("output/dithering", false).toBool());
+
     _ledMatrix->openPortByName(_settings->value("serial/interface").toString());
 }
 
 void Minotor::saveSettings()
 {
     _settings->setValue("renderer/size", _rendererSize);
+    _settings->setValue("renderer/supersampling", _supersampling);
     _settings->setValue("renderer/matrixSize", _matrixSize);
     _settings->setValue("renderer/panelSize", _panelSize);
 
     _settings->setValue("serial/interface", _ledMatrix->portName());
 
+    LedColorPipeline *pipeline = _ledMatrix->colorPipeline();
+    _settings->setValue("output/gamma", pipeline->gamma());
+    _settings->setValue("output/whiteBalance", pipeline->whiteBalance());
+    _settings->setValue("output/dithering", pipeline->isDithering());
+
     _settings->beginGroup("midi");
     _settings->beginGroup("interface");
     // Remove all interfaces
@@ -491,7 +593,8 @@ void Minotor::saveSettings()
     for(int i=0; i<midiInterfaces.count(); i++)
     {
         MidiInterface *midiInterface = midiInterfaces.at(i);
-        if(midiInterface->isUsed())
+        // Replay interfaces only live during a MIDI replay
+        if(midiInterface->isUsed() && !midiInterface->isReplay())
         {
             _settings->beginGroup(QString::number(id));
             QObject *object = static_cast<QObject*>(midiInterface);
@@ -550,7 +653,6 @@ void Minotor::save(MinoPersistentObject* object, QSettings* parser)
         }
         // Remove all entries in this group
         parser->remove("");
-        qDebug() << QString(" ").repeated(2) << object;
 
         if(!object->objectName().isEmpty())
             parser->setValue("objectName", object->objectName());
@@ -567,11 +669,6 @@ void Minotor::save(MinoPersistentObject* object, QSettings* parser)
             if(QString(omp.name()) != QString("objectName"))
             {
                 parser->setValue(omp.name(), omp.read(object));
-                qDebug() << QString(" ").repeated(3)
-                         << omp.typeName()
-                         << omp.name()
-                         << omp.read(object)
-                         << omp.isStored();
             }
         }
         // End of properties array
@@ -617,14 +714,49 @@ void Minotor::loadObjects(QSettings *parser, QObject *parent)
 {
     foreach(const QString& group, parser->childGroups())
     {
-        qDebug() << Q_FUNC_INFO
-                 << "group" << group;
         parser->beginGroup(group);
         loadObject(parser, group, parent);
         parser->endGroup();
     }
 }
 
+MinoPersistentObject *Minotor::createObject(const QString& className, const QString& objectName, QObject *parent)
+{
+    if(objectName.isEmpty())
+    {
+        // no objectName, that means we create the object
+        return MinoPersistentObjectFactory::createObject(className.toLatin1(), parent);
+    }
+    // objectName is filled, we will locate it from its parent
+    return parent->findChild<MinoPersistentObject*>(objectName);
+}
+
+void Minotor::attachObject(MinoPersistentObject *object, QObject *parent)
+{
+    // HACK: Group and Animations need to be explicitly added to their parent
+    if(MinoAnimationGroup *group = qobject_cast<MinoAnimationGroup*>(object))
+    {
+        MinoProgram *program = qobject_cast<MinoProgram*>(parent);
+        Q_ASSERT(program);
+        program->addAnimationGroup(group);
+    } else if (MinoAnimation *animation = qobject_cast<MinoAnimation*>(object))
+    {
+        MinoAnimationGroup *group = qobject_cast<MinoAnimationGroup*>(parent);
+        Q_ASSERT(group);
+        group->addAnimation(animation);
+    }
+}
+
+void Minotor::writeProperty(MinoPersistentObject *object, const QString& name, const QVariant& value)
+{
+    int index = object->metaObject()->indexOfProperty(name.toLatin1());
+    if(index != -1)
+    {
+        QMetaProperty omp = object->metaObject()->property(index) ;
+        omp.write(object, value);
+    }
+}
+
 void Minotor::loadObject(QSettings *parser, const QString& className, QObject *parent)
 {
     // Find the right parent
@@ -634,22 +766,7 @@ void Minotor::loadObject(QSettings *parser, const QString& className, QObject *p
     Q_ASSERT(parent);
 
     // Build or locate the object
-    MinoPersistentObject *object = NULL;
-    const QString objectName = parser->value("objectName").toString();
-    if(objectName.isEmpty())
-    {
-        // no objectName, that means we create the object
-        qDebug() << Q_FUNC_INFO
-                 << "instantiate object from class:" << className;
-        object = MinoPersistentObjectFactory::createObject(className.toLatin1(), parent);
-    }
-    else
-    {
-        // objectName is filled, we will locate it from its parent
-        qDebug() << Q_FUNC_INFO
-                 << "find an object named:" << parser->value("objectName").toString();
-        object = parent->findChild<MinoPersistentObject*>(objectName);
-    }
+    MinoPersistentObject *object = createObject(className, parser->value("objectName").toString(), parent);
 
     if(object)
     {
@@ -660,34 +777,12 @@ void Minotor::loadObject(QSettings *parser, const QString& className, QObject *p
             parser->setArrayIndex(i);
             foreach(const QString& key, parser->childKeys())
             {
-                qDebug() << Q_FUNC_INFO
-                         << QString("#%1 key:").arg(i) << key;
-                int index = object->metaObject()->indexOfProperty(key.toLatin1());
-                if(index != -1)
-                {
-                    QMetaProperty omp = object->metaObject()->property(index) ;
-                    omp.write(object, parser->value(key));
-                    qDebug() << Q_FUNC_INFO
-                             << "write property:" << key
-                             << "with value:" << parser->value(key)
-                             << "on object:" << object;
-                }
+                writeProperty(object, key, parser->value(key));
             }
         }
         parser->endArray();
 
-        // HACK: Group and Animations need to be explicitly added to their parent
-        if(MinoAnimationGroup *group = qobject_cast<MinoAnimationGroup*>(object))
-        {
-            MinoProgram *program = qobject_cast<MinoProgram*>(parent);
-            Q_ASSERT(program);
-            program->addAnimationGroup(group);
-        } else if (MinoAnimation *animation = qobject_cast<MinoAnimation*>(object))
-        {
-            MinoAnimationGroup *group = qobject_cast<MinoAnimationGroup*>(parent);
-            Q_ASSERT(group);
-            group->addAnimation(animation);
-        }
+        attachObject(object, parent);
 
         // Children
         size = parser->beginReadArray("children");
@@ -715,6 +810,88 @@ void Minotor::load(QSettings* parser)
     loadObjects(parser, NULL);
 }
 
+void Minotor::loadObject(const MinoBinaryBank *bank, const int index, QObject *parent)
+{
+    const QString className = bank->className(index);
+
+    // Find the right parent
+    if(!parent) {
+        parent = findParentFor(className);
+    }
+    Q_ASSERT(parent);
+
+    MinoPersistentObject *object = createObject(className, bank->objectName(index), parent);
+    if(!object)
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "ERROR: no object to fill...";
+        return;
+    }
+
+    // Property values are only decoded now
+    for(int i=0; i<bank->propertyCount(index); i++)
+    {
+        writeProperty(object, bank->propertyName(index, i), bank->propertyValue(index, i));
+    }
+
+    attachObject(object, parent);
+
+    foreach(const int child, bank->children(index))
+    {
+        loadObject(bank, child, object);
+    }
+
+    // HACK: MinoProgram bank need to be reloaded
+    if (MinoProgramBank *programBank = qobject_cast<MinoProgramBank*>(object))
+    {
+        changeProgramBank(programBank);
+    }
+}
+
+bool Minotor::loadFromFile(const QString &fileName)
+{
+    if(!QFile::exists(fileName))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "no such file:" << fileName;
+        return false;
+    }
+
+    if(MinoBinaryBank::isBinaryFile(fileName))
+    {
+        MinoBinaryBank bank(fileName);
+        if(!bank.open())
+            return false;
+        foreach(const int root, bank.roots())
+        {
+            loadObject(&bank, root, NULL);
+        }
+    }
+    else
+    {
+        // Legacy INI files
+        QSettings parser(fileName, QSettings::IniFormat);
+        load(&parser);
+    }
+    return true;
+}
+
+bool Minotor::saveToFile(MinoPersistentObject *object, const QString &fileName, const PersistenceFormat format)
+{
+    if(QFile::exists(fileName))
+    {
+        QFile::remove(fileName);
+    }
+    if(format == BinaryFormat)
+    {
+        return MinoBinaryBank::write(object, fileName);
+    }
+    QSettings parser(fileName, QSettings::IniFormat);
+    save(object, &parser);
+    parser.sync();
+    return (parser.status() == QSettings::NoError);
+}
+
 void Minotor::clearPrograms()
 {
     MinoProgramBank *programBank = new MinoProgramBank(this);
@@ -722,12 +899,49 @@ void Minotor::clearPrograms()
     changeProgramBank(programBank);
 }
 
+void Minotor::queueProgramBank(MinoProgramBank *bank)
+{
+    Q_ASSERT(bank);
+    if(_pendingProgramBank && (_pendingProgramBank != bank))
+    {
+        _pendingProgramBank->deleteLater();
+    }
+    if(_clockSource->isEnabled())
+    {
+        bank->setVisible(false);
+        _pendingProgramBank = bank;
+        _pendingProgramBankTimer.start();
+    }
+    else
+    {
+        _pendingProgramBank = NULL;
+        _pendingProgramBankTimer.stop();
+        changeProgramBank(bank);
+    }
+}
+
+void Minotor::checkPendingProgramBank()
+{
+    if(_pendingProgramBank && (_lastClock.elapsed() >= MINOTOR_STALLED_CLOCK_MS))
+    {
+        MinoProgramBank *bank = _pendingProgramBank;
+        _pendingProgramBank = NULL;
+        changeProgramBank(bank);
+    }
+    if(!_pendingProgramBank)
+        _pendingProgramBankTimer.stop();
+}
+
 void Minotor::changeProgramBank(MinoProgramBank *bank)
 {
     _master->setProgram(NULL);
-    delete _programBank;
+    // Previous bank is destroyed once current frame is done
+    _programBank->setVisible(false);
+    _programBank->deleteLater();
     _programBank = bank;
     Q_ASSERT(bank);
+    bank->setVisible(true);
+    bank->registerTriggers();
     if(bank->programs().count())
     {
         // Use the first available program as master
@@ -736,54 +950,6 @@ void Minotor::changeProgramBank(MinoProgramBank *bank)
     emit programBankChanged(bank);
 }
 
-QPixmap* Minotor::graphicsItemToPixmap(QGraphicsItem *item)
-{
-    const qreal width = 24.0;
-    const qreal height = 16.0;
-    QPixmap *pixmap = new QPixmap(width, height);
-    pixmap->fill(Qt::black);
-
-    QPainter painter(pixmap);
-
-    // Render a part of scene dedicated to screenshot (0,0)
-    const QPointF screeningPos(0,0);
-    QPointF fromScenePos = item->scenePos();
-    QPointF fromPos = item->pos();
-    item->setPos(item->mapFromScene(screeningPos));
-    _scene.render(&painter, QRectF(0,0,width,height), QRectF(screeningPos, displayRect().size()), Qt::IgnoreAspectRatio);
-    item->setPos(fromPos);
-    Q_ASSERT(item->scenePos() == fromScenePos);
-
-//    // Computes grids lines
-//    QVector<QLine> gridLines;
-//    qreal gridStepMin;
-
-//    const QRect rect = displayRect();
-//    gridLines.clear();
-//    const qreal stepX =  width / rect.width();
-//    const qreal stepY = height / rect.height();
-//    for (int x = 1; x < rect.width(); x++)
-//    {
-//        int pos = x * stepX;
-//        gridLines.append(QLine(pos,0,pos,height));
-//    }
-//    for (int y = 1; y < rect.height(); y++)
-//    {
-//        int pos = y * stepY;
-//        gridLines.append(QLine(0,pos,width,pos));
-//    }
-//    gridStepMin = qMin(stepX, stepY);
-
-//    QPen pen;
-//    pen.setWidthF(gridStepMin*0.25);
-//    pen.setColor(Qt::red);
-//    painter.setPen(pen);
-
-//    painter.drawLines(gridLines);
-
-    return pixmap;
-}
-
 void Minotor::setRendererSize(const QSize &size)
 {
      if (size.isValid())
@@ -796,6 +962,23 @@ void Minotor::setRendererSize(const QSize &size)
      }
 }
 
+void Minotor::setSupersampling(const int factor)
+{
+    if((factor != 1) && (factor != 2) && (factor != 4))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "Unsupported supersampling factor" << factor;
+        return;
+    }
+    if(_supersampling != factor)
+    {
+        _supersampling = factor;
+        _programBank->setSupersampling(factor);
+        if(_pendingProgramBank)
+            _pendingProgramBank->setSupersampling(factor);
+    }
+}
+
 void Minotor::setMatrixSize(const QSize &size)
 {
      if (size.isValid())
@@ -22,6 +22,8 @@
 #define MINOTOR_H
 
 #include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include <QGraphicsScene>
 #include <QGraphicsItemGroup>
@@ -38,10 +40,13 @@
 #include "minoprogrambank.h"
 
 class MinoAnimation;
+class MinoBinaryBank;
+class MinoProgramBankLoader;
 
 class Minotor : public QObject
 {
     Q_OBJECT
+    friend class MinoProgramBankLoader;
 public:
     explicit Minotor(QObject *parent = 0);
     ~Minotor();
@@ -62,6 +67,8 @@ public:
 
     // Clock source
     MinoClockSource *clockSource() { return _clockSource; }
+    // Note (played at timestamp) has been rendered by master program: its latency is reported once frame is sent
+    void notifyNoteOnAir(const qint64 timestamp) { _onAirNotes.append(timestamp); }
 
     // Display rect (used by MinoAnimations to know drawing area)
     const QRect displayRect() const { return QRect(QPoint(0,0), _rendererSize); }
@@ -70,6 +77,11 @@ public:
     const QSize rendererSize() const { return _rendererSize; }
     void setRendererSize(const QSize& size);
 
+    // Programs render at renderer size multiplied by supersampling factor (1, 2 or 4),
+    // LED matrix downsamples rendering to its own size
+    int supersampling() const { return _supersampling; }
+    void setSupersampling(const int factor);
+
     // Matrix size accessors
     const QSize matrixSize() const { return _matrixSize; }
     void setMatrixSize(const QSize& size);
@@ -82,17 +94,22 @@ public:
     static Minotor *minotor() { static Minotor *minotor = new Minotor(); return minotor; }
 
     // Persistence
+    enum PersistenceFormat { BinaryFormat, IniFormat };
     void save(MinoPersistentObject* object, QSettings* parser);
     void load(QSettings* parser);
+    // Format is detected when loading
+    bool loadFromFile(const QString &fileName);
+    bool saveToFile(MinoPersistentObject *object, const QString &fileName, const PersistenceFormat format = BinaryFormat);
 
     //Program Bank
     MinoProgramBank* programBank() { return _programBank; }
     void changeProgramBank(MinoProgramBank *bank);
+    // Bank will replace current one on next beat (or now if clock is stopped, or as soon as it stalls)
+    void queueProgramBank(MinoProgramBank *bank);
+    // Background loading of program banks
+    MinoProgramBankLoader *programBankLoader() { return _programBankLoader; }
     void clearPrograms();
 
-    // Screenshots
-    QPixmap* graphicsItemToPixmap(QGraphicsItem *item);
-
     // Debug
     void initWithDebugSetup();
 
@@ -115,6 +132,9 @@ public slots:
     // Midi messages handlers
     void handleMidiInterfaceProgramChange(int interface, quint8 channel, quint8 program);
 
+private slots:
+    void checkPendingProgramBank();
+
 private:
     // Settings
     QSettings *_settings;
@@ -124,6 +144,7 @@ private:
     // Scene
     QGraphicsScene _scene;
     QSize _rendererSize;
+    int _supersampling;
     QSize _matrixSize;
     QSize _panelSize;
 
@@ -144,10 +165,25 @@ private:
 
     void loadObject(QSettings* parser, const QString &className, QObject *parent);
     void loadObjects(QSettings *parser, QObject *parent);
+    void loadObject(const MinoBinaryBank *bank, const int index, QObject *parent);
+    MinoPersistentObject *createObject(const QString& className, const QString& objectName, QObject *parent);
+    void attachObject(MinoPersistentObject *object, QObject *parent);
+    void writeProperty(MinoPersistentObject *object, const QString& name, const QVariant& value);
 
     QObject *findParentFor(const QString& className);
 
     MinoProgramBank *_programBank;
+    MinoProgramBank *_pendingProgramBank;
+    // Pending bank is swapped without waiting for a beat when clock stalls (ie. external clock stopped sending)
+    QTimer _pendingProgramBankTimer;
+    QElapsedTimer _lastClock;
+    MinoProgramBankLoader *_programBankLoader;
+
+    // Timestamps of notes rendered in current frame
+    QList<qint64> _onAirNotes;
+
+    // A black frame has already been sent to LED matrix (ie. brightness is off)
+    bool _ledMatrixBlackedOut;
 };
 
 #endif // MINOTOR_H
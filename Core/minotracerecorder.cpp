@@ -0,0 +1,153 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minotracerecorder.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QThread>
+
+#include "minoprofiler.h"
+
+MinoTraceRecorder::MinoTraceRecorder() :
+    _recording(false),
+    _next(0),
+    _wrapped(false)
+{
+}
+
+void MinoTraceRecorder::start(const int capacity)
+{
+    Q_ASSERT(capacity > 0);
+    QMutexLocker locker(&_mutex);
+    _events.resize(capacity);
+    _next = 0;
+    _wrapped = false;
+    _recording = true;
+}
+
+void MinoTraceRecorder::stop()
+{
+    _recording = false;
+}
+
+int MinoTraceRecorder::eventCount()
+{
+    QMutexLocker locker(&_mutex);
+    return _wrapped ? _events.count() : _next;
+}
+
+void MinoTraceRecorder::append(const Event &event)
+{
+    QMutexLocker locker(&_mutex);
+    if(!_recording || _events.isEmpty())
+        return;
+    _events[_next] = event;
+    if(++_next == _events.count())
+    {
+        _next = 0;
+        _wrapped = true;
+    }
+}
+
+void MinoTraceRecorder::span(const int key, const qint64 start, const qint64 duration)
+{
+    Event event;
+    event.key = key;
+    event.timestamp = start;
+    event.duration = duration;
+    event.thread = (quintptr)QThread::currentThreadId();
+    event.value = 0;
+    append(event);
+}
+
+void MinoTraceRecorder::instant(const int key, const qint64 timestamp, const int value)
+{
+    Event event;
+    event.key = key;
+    event.timestamp = timestamp;
+    event.duration = -1;
+    event.thread = (quintptr)QThread::currentThreadId();
+    event.value = value;
+    append(event);
+}
+
+bool MinoTraceRecorder::dump(const QString &fileName)
+{
+    // Snapshot buffer in chronological order, so recording can go on while writing
+    QVector<Event> events;
+    {
+        QMutexLocker locker(&_mutex);
+        if(_wrapped)
+            events = _events.mid(_next) + _events.mid(0, _next);
+        else
+            events = _events.mid(0, _next);
+    }
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "unable to open" << fileName;
+        return false;
+    }
+
+    // Thread IDs are replaced by small numbers (rendering thread first seen is 1)
+    QHash<quintptr, int> threads;
+    QHash<int, QString> names;
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    for(int i=0; i<events.count(); i++)
+    {
+        const Event &event = events.at(i);
+        int tid = threads.value(event.thread, 0);
+        if(!tid)
+        {
+            tid = threads.count() + 1;
+            threads.insert(event.thread, tid);
+        }
+        if(!names.contains(event.key))
+        {
+            QString name = MinoProfiler::profiler()->keyName(event.key);
+            names.insert(event.key, name.replace('\\', "\\\\").replace('"', "\\\""));
+        }
+
+        // Chrome trace timestamps are microseconds
+        out << "{\"name\": \"" << names.value(event.key) << "\", \"pid\": 1, \"tid\": " << tid
+            << ", \"ts\": " << QString::number((qreal)event.timestamp / 1000.0, 'f', 3);
+        if(event.duration >= 0)
+        {
+            out << ", \"ph\": \"X\", \"dur\": " << QString::number((qreal)event.duration / 1000.0, 'f', 3);
+        }
+        else
+        {
+            out << ", \"ph\": \"i\", \"s\": \"t\", \"args\": {\"value\": " << event.value << "}";
+        }
+        out << "}" << ((i < events.count()-1) ? ",\n" : "\n");
+    }
+    out << "]}\n";
+    out.flush();
+    return (file.error() == QFile::NoError);
+}
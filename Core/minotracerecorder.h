@@ -0,0 +1,71 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOTRACERECORDER_H
+#define MINOTRACERECORDER_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Opt-in timeline recorder: keeps last events in a bounded buffer and dumps them
+// as a Chrome trace (JSON, readable by chrome://tracing and Perfetto UI)
+class MinoTraceRecorder
+{
+public:
+    // Singleton accessor
+    static MinoTraceRecorder *recorder() { static MinoTraceRecorder *recorder = new MinoTraceRecorder(); return recorder; }
+
+    // Start recording, keeping at most capacity events (oldest are overwritten)
+    void start(const int capacity = 65536);
+    void stop();
+    bool isRecording() const { return _recording; }
+
+    // Events, named by MinoProfiler keys. Timestamps are MinoProfiler::now() ns
+    void span(const int key, const qint64 start, const qint64 duration);
+    void instant(const int key, const qint64 timestamp, const int value);
+
+    // Write buffered events to fileName (Chrome JSON trace format)
+    bool dump(const QString &fileName);
+
+    int eventCount();
+
+private:
+    MinoTraceRecorder();
+
+    struct Event {
+        int key;
+        qint64 timestamp;
+        qint64 duration; // -1 for instant events
+        quintptr thread;
+        int value;
+    };
+
+    volatile bool _recording;
+    QMutex _mutex;
+    QVector<Event> _events;
+    int _next;
+    bool _wrapped;
+
+    void append(const Event &event);
+};
+
+#endif // MINOTRACERECORDER_H
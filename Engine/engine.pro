@@ -0,0 +1,36 @@
+#-------------------------------------------------
+#
+# Minotor headless engine (no MainWindow)
+#
+#-------------------------------------------------
+
+QT       += core gui network
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = minotor-engine
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../minotor.pri)
+
+SOURCES += \
+    main.cpp \
+    minoengineserver.cpp \
+    minoofflinerenderer.cpp
+
+HEADERS += \
+    minoengineserver.h \
+    minoofflinerenderer.h
+
+# Built-in MIDI mappings
+RESOURCES += \
+    ../minotor.qrc
+
+unix {
+  isEmpty(PREFIX) {
+    PREFIX = /usr
+  }
+  target.path = $$PREFIX/bin
+  INSTALLS += target
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <QApplication>
+#include <QStringList>
+
+#include <QDebug>
+
+#include "minotor.h"
+#include "minoengineserver.h"
+#include "minoofflinerenderer.h"
+#include "minoprofiler.h"
+
+static void usage()
+{
+    qDebug() << "Usage: minotor-engine [options]";
+    qDebug() << "  --bank <file.mpb>   program bank to load";
+    qDebug() << "  --bpm <value>       internal clock tempo";
+    qDebug() << "  --midi-clock        follow external MIDI clock";
+    qDebug() << "  --socket <name>     local control socket name (default: minotor-engine)";
+    qDebug() << "  --render <file>     render offline, as fast as possible, then quit";
+    qDebug() << "                      (.y4m video, .png sequence or raw RGB frames)";
+    qDebug() << "  --beats <value>     offline rendering length (default: recording length or 16)";
+    qDebug() << "  --replay <file>     MIDI recording played during offline rendering";
+}
+
+int main(int argc, char *argv[])
+{
+    // Startup timings are relative to this point
+    MinoProfiler::profiler()->mark("process started");
+
+#if QT_VERSION >= 0x050000
+    // No display server is needed: render with offscreen platform unless told otherwise
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication a(argc, argv);
+#else
+    QApplication a(argc, argv, false);
+#endif
+    a.setApplicationName("Minotor");
+
+    QString bankFileName;
+    QString socketName("minotor-engine");
+    double bpm = 0.0;
+    bool midiClock = false;
+    QString renderFileName;
+    QString replayFileName;
+    double beats = 0.0;
+
+    const QStringList args = a.arguments();
+    for(int i=1; i<args.count(); i++)
+    {
+        const QString arg = args.at(i);
+        const bool hasValue = (i+1) < args.count();
+        if((arg == "--bank") && hasValue)
+            bankFileName = args.at(++i);
+        else if((arg == "--bpm") && hasValue)
+            bpm = args.at(++i).toDouble();
+        else if((arg == "--socket") && hasValue)
+            socketName = args.at(++i);
+        else if((arg == "--render") && hasValue)
+            renderFileName = args.at(++i);
+        else if((arg == "--beats") && hasValue)
+            beats = args.at(++i).toDouble();
+        else if((arg == "--replay") && hasValue)
+            replayFileName = args.at(++i);
+        else if(arg == "--midi-clock")
+            midiClock = true;
+        else
+        {
+            usage();
+            return (arg == "--help")?0:1;
+        }
+    }
+
+    // Auto-create minotor instance
+    Minotor *minotor = Minotor::minotor();
+    minotor->loadSettings();
+    MinoProfiler::profiler()->mark("settings loaded");
+
+    MinoEngineServer server(minotor);
+    if(bankFileName.isEmpty() || !server.loadProgramBank(bankFileName))
+    {
+        minotor->clearPrograms();
+    }
+
+    MinoClockSource *clockSource = minotor->clockSource();
+    if(bpm > 0.0)
+        clockSource->setBPM(bpm);
+
+    // Offline rendering: no control socket, no timer
+    if(!renderFileName.isEmpty())
+    {
+        bool success = false;
+        {
+            MinoOfflineRenderer renderer(minotor);
+            renderer.setBeats(beats);
+            if(replayFileName.isEmpty() || renderer.setMidiRecording(replayFileName))
+                success = renderer.render(renderFileName, MinoFrameDumper::formatForFileName(renderFileName));
+        }
+        delete Minotor::minotor();
+        return success?0:1;
+    }
+
+    clockSource->setExternalClockSource(midiClock);
+    clockSource->uiStart();
+
+    server.listen(socketName);
+
+    int ret = a.exec();
+
+    delete Minotor::minotor();
+
+    return ret;
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoengineserver.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include "minotor.h"
+#include "minopropertyreal.h"
+#include "midicontrollablelist.h"
+#include "minoprofiler.h"
+#include "minotracerecorder.h"
+#include "minoframedumper.h"
+#include "midirecorder.h"
+#include "midireplayer.h"
+#include "ledmatrix.h"
+#include "minoprogrambankloader.h"
+
+MinoEngineServer::MinoEngineServer(Minotor *minotor, QObject *parent) :
+    QObject(parent),
+    _minotor(minotor),
+    _replayer(NULL)
+{
+    connect(&_server, SIGNAL(newConnection()), this, SLOT(newConnection()));
+    connect(_minotor->programBankLoader(), SIGNAL(loaded(bool)), this, SLOT(programBankLoaded(bool)));
+}
+
+bool MinoEngineServer::listen(const QString &name)
+{
+    // Remove stale socket left by a previous (crashed) instance
+    QLocalServer::removeServer(name);
+    if(!_server.listen(name))
+    {
+        qDebug() << Q_FUNC_INFO
+                 << "Unable to listen on:" << name << _server.errorString();
+        return false;
+    }
+    qDebug() << "Engine listening on:" << _server.fullServerName();
+    return true;
+}
+
+bool MinoEngineServer::loadProgramBank(const QString &fileName)
+{
+    // Binary banks are loaded in background, legacy INI ones synchronously
+    switch(_minotor->programBankLoader()->load(fileName))
+    {
+    case MinoProgramBankLoader::Loading:
+        return true;
+    case MinoProgramBankLoader::Busy:
+        return false;
+    case MinoProgramBankLoader::NotBinary:
+        break;
+    }
+    return _minotor->loadFromFile(fileName);
+}
+
+void MinoEngineServer::newConnection()
+{
+    while(QLocalSocket *socket = _server.nextPendingConnection())
+    {
+        connect(socket, SIGNAL(readyRead()), this, SLOT(readClient()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+    }
+}
+
+void MinoEngineServer::readClient()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    Q_ASSERT(socket);
+    processCommands(socket);
+}
+
+void MinoEngineServer::processCommands(QLocalSocket *socket)
+{
+    while((socket != _loadClient) && socket->canReadLine())
+    {
+        const QString line = QString::fromUtf8(socket->readLine()).trimmed();
+        if(line.isEmpty())
+            continue;
+        const QString reply = handleCommand(line, socket);
+        if(!reply.isEmpty())
+            socket->write(reply.toUtf8() + '\n');
+    }
+}
+
+void MinoEngineServer::programBankLoaded(bool success)
+{
+    QLocalSocket *socket = _loadClient;
+    _loadClient = NULL;
+    if(!socket)
+        return;
+    socket->write((success ? QString("ok") : ("error: unable to load " + _loadFileName)).toUtf8() + '\n');
+    processCommands(socket);
+}
+
+QString MinoEngineServer::handleCommand(const QString &line, QLocalSocket *client)
+{
+    const QStringList args = line.split(' ', QString::SkipEmptyParts);
+    const QString command = args.first().toLower();
+    MinoClockSource *clockSource = _minotor->clockSource();
+
+    if(command == "play")
+    {
+        clockSource->uiStart();
+    }
+    else if(command == "stop")
+    {
+        clockSource->uiStop();
+    }
+    else if(command == "sync")
+    {
+        clockSource->uiSync();
+    }
+    else if(command == "bpm")
+    {
+        if(args.count() > 1)
+        {
+            bool ok = false;
+            const double bpm = args.at(1).toDouble(&ok);
+            if(!ok || (bpm <= 0.0))
+                return "error: invalid bpm";
+            clockSource->setBPM(bpm);
+        }
+        return QString("ok %1").arg(clockSource->bpm());
+    }
+    else if(command == "clock")
+    {
+        if(args.count() < 2)
+            return QString("ok %1").arg(clockSource->useExternalClockSource()?"midi":"internal");
+        if(args.at(1) == "midi")
+            clockSource->setExternalClockSource(true);
+        else if(args.at(1) == "internal")
+            clockSource->setExternalClockSource(false);
+        else
+            return "error: clock is either internal or midi";
+    }
+    else if(command == "program")
+    {
+        QList<MinoProgram*> programs = _minotor->programBank()->programs();
+        if(args.count() < 2)
+            return QString("ok %1").arg(programs.indexOf(_minotor->master()->program()));
+        bool ok = false;
+        const int id = args.at(1).toInt(&ok);
+        if(!ok || (id < 0) || (id >= programs.count()))
+            return "error: invalid program";
+        _minotor->master()->setProgram(programs.at(id));
+    }
+    else if(command == "brightness")
+    {
+        MinoPropertyReal *brightness = _minotor->master()->findChild<MinoPropertyReal*>("master-brightness");
+        Q_ASSERT(brightness);
+        if(args.count() > 1)
+        {
+            bool ok = false;
+            const qreal value = args.at(1).toDouble(&ok);
+            if(!ok)
+                return "error: invalid brightness";
+            brightness->setValue(qBound(0.0, value, 1.0));
+        }
+        return QString("ok %1").arg(brightness->value());
+    }
+    else if(command == "transition")
+    {
+        MidiControllableList *transition = _minotor->master()->findChild<MidiControllableList*>("master-transition");
+        MidiControllableList *length = _minotor->master()->findChild<MidiControllableList*>("master-transition-length");
+        Q_ASSERT(transition && length);
+        if(args.count() > 1)
+        {
+            // Unknown names leave current item unchanged
+            transition->setCurrentItemFromString(args.at(1));
+            if(transition->currentItem()->name() != args.at(1))
+                return "error: transition is either cut, fade or wipe";
+        }
+        if(args.count() > 2)
+        {
+            length->setCurrentItemFromString(args.at(2));
+            if(length->currentItem()->name() != args.at(2))
+                return "error: transition length is 1, 2, 4 or 8 beats";
+        }
+        return QString("ok %1 %2").arg(transition->currentItem()->name()).arg(length->currentItem()->name());
+    }
+    else if(command == "load")
+    {
+        // File name may contain spaces
+        const QString fileName = line.section(' ', 1).trimmed();
+        switch(_minotor->programBankLoader()->load(fileName))
+        {
+        case MinoProgramBankLoader::Loading:
+            if(!client)
+                return "ok";
+            // Reply once bank is loaded (see programBankLoaded())
+            _loadClient = client;
+            _loadFileName = fileName;
+            return QString();
+        case MinoProgramBankLoader::Busy:
+            return "error: a program bank is already being loaded";
+        case MinoProgramBankLoader::NotBinary:
+            if(!_minotor->loadFromFile(fileName))
+                return "error: unable to load " + fileName;
+            break;
+        }
+    }
+    else if(command == "stats")
+    {
+        // Frame timings, as a JSON array on a single line
+        if((args.count() > 1) && (args.at(1) == "reset"))
+            MinoProfiler::profiler()->reset();
+        else if((args.count() > 1) && (args.at(1) == "startup"))
+            return "ok " + MinoProfiler::profiler()->startupReport().replace('\n', "; ");
+        else
+            return "ok " + MinoProfiler::profiler()->statsToJson();
+    }
+    else if(command == "trace")
+    {
+        MinoTraceRecorder *recorder = MinoTraceRecorder::recorder();
+        const QString action = args.value(1);
+        if(action == "start")
+        {
+            bool ok = true;
+            const int capacity = (args.count() > 2) ? args.at(2).toInt(&ok) : 65536;
+            if(!ok || (capacity <= 0))
+                return "error: invalid capacity";
+            recorder->start(capacity);
+        }
+        else if(action == "stop")
+        {
+            recorder->stop();
+        }
+        else if(action == "dump")
+        {
+            const QString fileName = line.section(' ', 2).trimmed();
+            if(fileName.isEmpty() || !recorder->dump(fileName))
+                return "error: unable to write " + fileName;
+            return QString("ok %1").arg(recorder->eventCount());
+        }
+        else
+        {
+            return "error: usage: trace start [capacity]|stop|dump <file>";
+        }
+    }
+    else if(command == "record")
+    {
+        MidiRecorder *recorder = MidiRecorder::recorder();
+        const QString action = args.value(1);
+        if(action == "start")
+        {
+            const QString fileName = line.section(' ', 2).trimmed();
+            if(fileName.isEmpty() || !recorder->start(fileName))
+                return "error: unable to write " + fileName;
+        }
+        else if(action == "stop")
+        {
+            recorder->stop();
+            return QString("ok %1").arg(recorder->messageCount());
+        }
+        else
+        {
+            return "error: usage: record start <file>|stop";
+        }
+    }
+    else if(command == "replay")
+    {
+        if(!_replayer)
+            _replayer = new MidiReplayer(_minotor->midi(), this);
+        if(args.value(1) == "stop")
+        {
+            _replayer->stop();
+        }
+        else
+        {
+            if(args.count() < 2)
+                return "error: usage: replay <file> [speed]|stop";
+            bool ok = true;
+            const qreal speed = (args.count() > 2) ? args.at(2).toDouble(&ok) : 1.0;
+            if(!ok || (speed < 0.0))
+                return "error: invalid speed";
+            if(!_replayer->load(args.at(1)))
+                return "error: unable to read " + args.at(1);
+            _replayer->play(speed);
+            return QString("ok %1").arg(_replayer->messageCount());
+        }
+    }
+    else if(command == "frames")
+    {
+        MinoFrameDumper *dumper = MinoFrameDumper::dumper();
+        const QString action = args.value(1);
+        if(action == "start")
+        {
+            const QString fileName = line.section(' ', 2).trimmed();
+            // A frame is rendered every 2 pulses (12 per beat)
+            const qreal fps = clockSource->bpm() / 5.0;
+            if(fileName.isEmpty() || !dumper->start(fileName, _minotor->ledMatrix()->size(), MinoFrameDumper::formatForFileName(fileName), fps))
+                return "error: unable to write " + fileName;
+            return QString("ok %1x%2").arg(dumper->size().width()).arg(dumper->size().height());
+        }
+        else if(action == "stop")
+        {
+            dumper->stop();
+            return QString("ok %1").arg(dumper->frameCount());
+        }
+        else
+        {
+            return "error: usage: frames start <file>|stop";
+        }
+    }
+    else if(command == "quit")
+    {
+        QCoreApplication::quit();
+    }
+    else
+    {
+        return "error: unknown command " + command;
+    }
+    return "ok";
+}
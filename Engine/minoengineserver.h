@@ -0,0 +1,69 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOENGINESERVER_H
+#define MINOENGINESERVER_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStringList>
+#include <QPointer>
+
+class Minotor;
+class MidiReplayer;
+
+// Local socket control interface of headless engine.
+// Protocol is line based: one command per line, one reply per line
+// ("ok [value]" or "error: <reason>").
+class MinoEngineServer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MinoEngineServer(Minotor *minotor, QObject *parent = 0);
+
+    bool listen(const QString &name);
+    QString serverName() const { return _server.fullServerName(); }
+
+    // Load a program bank (.mpb) and put its first program on air
+    bool loadProgramBank(const QString &fileName);
+
+    // Returns reply, or an empty string when reply is deferred to client
+    // (ie. "load" replies once bank is loaded in background)
+    QString handleCommand(const QString &line, QLocalSocket *client = NULL);
+
+private:
+    Minotor *_minotor;
+    QLocalServer _server;
+    MidiReplayer *_replayer;
+
+    // Client waiting for background "load" reply: its next commands wait too (replies keep commands order)
+    QPointer<QLocalSocket> _loadClient;
+    QString _loadFileName;
+    void processCommands(QLocalSocket *socket);
+
+private slots:
+    void newConnection();
+    void readClient();
+    void programBankLoaded(bool success);
+};
+
+#endif // MINOENGINESERVER_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "minoofflinerenderer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <qmath.h>
+
+#include "minotor.h"
+#include "minoprogrambankloader.h"
+#include "minonulldevice.h"
+#include "ledmatrix.h"
+#include "midireplayer.h"
+
+MinoOfflineRenderer::MinoOfflineRenderer(Minotor *minotor, QObject *parent) :
+    QObject(parent),
+    _minotor(minotor),
+    _replayer(NULL),
+    _beats(0.0)
+{
+}
+
+bool MinoOfflineRenderer::setMidiRecording(const QString &fileName)
+{
+    if(!_replayer)
+        _replayer = new MidiReplayer(_minotor->midi(), this);
+    return _replayer->load(fileName);
+}
+
+void MinoOfflineRenderer::waitForProgramBank()
+{
+    MinoProgramBankLoader *loader = _minotor->programBankLoader();
+    QEventLoop loop;
+    connect(loader, SIGNAL(loaded(bool)), &loop, SLOT(quit()));
+    if(loader->isLoading())
+        loop.exec();
+
+    // Background setup (ie. image decoding) would end at a pulse depending on threads timing
+    foreach(MinoProgram *program, _minotor->programBank()->programs())
+    {
+        program->waitForFrames();
+    }
+}
+
+bool MinoOfflineRenderer::render(const QString &fileName, const MinoFrameDumper::Format format)
+{
+    waitForProgramBank();
+
+    MinoClockSource *clockSource = _minotor->clockSource();
+    clockSource->setExternalClockSource(false);
+    clockSource->setManual(true);
+
+    // Frames only go to disk
+    LedMatrix *ledMatrix = _minotor->ledMatrix();
+    ledMatrix->closePort();
+    MinoNullDevice nullDevice;
+    nullDevice.open(QIODevice::WriteOnly);
+    ledMatrix->setOutputDevice(&nullDevice);
+
+    // Timeline: pulses are placed on a virtual time axis (shared with replayed notes timestamps)
+    const qreal bpm = clockSource->bpm();
+    const qreal pulseNs = 60000000000.0 / (bpm * 24.0);
+    qreal beats = _beats;
+    if(beats <= 0.0)
+        beats = _replayer ? qCeil(((qreal)_replayer->duration() * 1000.0) / (pulseNs * 24.0)) + 1 : 16;
+    const unsigned int pulses = beats * 24;
+
+    MinoFrameDumper *dumper = MinoFrameDumper::dumper();
+    if(!dumper->start(fileName, ledMatrix->size(), format, bpm / 5.0))
+    {
+        ledMatrix->setOutputDevice(NULL);
+        return false;
+    }
+    if(_replayer)
+        _replayer->rewind();
+
+    QElapsedTimer timer;
+    timer.start();
+    clockSource->uiStart();
+    for(unsigned int pulse=0; pulse<pulses; pulse++)
+    {
+        const qint64 time = (qint64)(pulse * pulseNs);
+        if(_replayer)
+            _replayer->deliverUntil(time / 1000);
+        clockSource->pulse(time);
+        // Deferred work (ie. program bank materialization, deferred deletes) is done once per frame
+        // Note: processEvents() doesn't deliver DeferredDelete events, they are sent explicitly
+        if((pulse % 2) == 0)
+        {
+            QCoreApplication::processEvents();
+            QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+        }
+    }
+    clockSource->uiStop();
+    dumper->stop();
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    ledMatrix->setOutputDevice(NULL);
+    clockSource->setManual(false);
+
+    const qreal duration = (qreal)pulses * pulseNs;
+    qDebug() << "Offline rendering:" << dumper->frameCount() << "frames" << qPrintable(QString("(%1 beats at %2 bpm)").arg(beats).arg(bpm))
+             << "in" << qPrintable(QString("%1 s").arg((qreal)elapsed / 1000000000.0, 0, 'f', 3))
+             << qPrintable(QString("for %1 s of show: %2x real time").arg(duration / 1000000000.0, 0, 'f', 3).arg(duration / qMax((qreal)1.0, (qreal)elapsed), 0, 'f', 1));
+    return dumper->frameCount() > 0;
+}
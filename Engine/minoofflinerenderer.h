@@ -0,0 +1,57 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINOOFFLINERENDERER_H
+#define MINOOFFLINERENDERER_H
+
+#include <QObject>
+
+#include "minoframedumper.h"
+
+class Minotor;
+class MidiReplayer;
+
+// Batch rendering of loaded program bank, as fast as the CPU allows:
+// clock is pulsed by a loop (internal timer is never started), MIDI messages come from
+// a MidiRecorder log (optional) and frames are written by MinoFrameDumper.
+// Tempo is the clock source one: recorded MIDI clock is not followed.
+class MinoOfflineRenderer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MinoOfflineRenderer(Minotor *minotor, QObject *parent = 0);
+
+    // Rendering length (0: recording length, or 16 beats without recording)
+    void setBeats(const qreal beats) { _beats = beats; }
+    bool setMidiRecording(const QString &fileName);
+
+    bool render(const QString &fileName, const MinoFrameDumper::Format format);
+
+private:
+    Minotor *_minotor;
+    MidiReplayer *_replayer;
+    qreal _beats;
+
+    // Bank loading and animations' background setup are over before first pulse
+    void waitForProgramBank();
+};
+
+#endif // MINOOFFLINERENDERER_H
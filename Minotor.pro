@@ -10,58 +10,9 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 TARGET = minotor
 TEMPLATE = app
 
+include(minotor.pri)
 
 SOURCES += \
-    Animation/minaballs.cpp \
-    Animation/minabarsfromsides.cpp \
-    Animation/minacurve.cpp \
-    Animation/minadebug.cpp \
-    Animation/minaexpandingobjects.cpp \
-    Animation/minafallingobjects.cpp \
-    Animation/minaflash.cpp \
-    Animation/minaflashbars.cpp \
-    Animation/minagradient.cpp \
-    Animation/minaimage.cpp \
-    Animation/minaplasma.cpp \
-    Animation/minarainbowoil.cpp \
-    Animation/minarandompixels.cpp \
-    Animation/minarotatingbars.cpp \
-    Animation/minastars.cpp \
-    Animation/minatext.cpp \
-    Animation/minavibration.cpp \
-    Animation/minawaveform.cpp \
-    Core/Midi/midi.cpp \
-    Core/Midi/midicontrol.cpp \
-    Core/Midi/midicontrollablelist.cpp \
-    Core/Midi/midicontrollableparameter.cpp \
-    Core/Midi/midicontrollablereal.cpp \
-    Core/Midi/midiinterface.cpp \
-    Core/Midi/midimapper.cpp \
-    Core/Midi/midimapping.cpp \
-    Core/Property/minoitemizedproperty.cpp \
-    Core/Property/minoproperty.cpp \
-    Core/Property/minopropertybeat.cpp \
-    Core/Property/minopropertycolor.cpp \
-    Core/Property/minopropertyeasingcurve.cpp \
-    Core/Property/minopropertyfilename.cpp \
-    Core/Property/minopropertyreal.cpp \
-    Core/Property/minopropertytext.cpp \
-    Core/easingcurvedreal.cpp \
-    Core/ledmatrix.cpp \
-    Core/minoanimation.cpp \
-    Core/minoanimationgroup.cpp \
-    Core/minoclocksource.cpp \
-    Core/minocontrol.cpp \
-    Core/minoinstrumentedanimation.cpp \
-    Core/minomaster.cpp \
-    Core/minomastermidimapper.cpp \
-    Core/minopersistentobject.cpp \
-    Core/minopersistentobjectfactory.cpp \
-    Core/minoprogram.cpp \
-    Core/minoprogrambank.cpp \
-    Core/minopropertymidichannel.cpp \
-    Core/minotor.cpp \
-    Core/minotrigger.cpp \
     Ui/Widget/uianimation.cpp \
     Ui/Widget/uianimationdescription.cpp \
     Ui/Widget/uianimationgroup.cpp \
@@ -74,69 +25,20 @@ SOURCES += \
     Ui/Widget/uimastercontrol.cpp \
     Ui/Widget/uimidicontrollableparameter.cpp \
     Ui/Widget/uimidiinterface.cpp \
+    Ui/Widget/uiperformancehud.cpp \
+    Ui/Widget/uipreviewcompositor.cpp \
     Ui/Widget/uiprogram.cpp \
     Ui/Widget/uiprogrambank.cpp \
     Ui/Widget/uiprogrameditor.cpp \
     Ui/Widget/uiprogramview.cpp \
+    Ui/Widget/uiupdatecoalescer.cpp \
     Ui/configdialog.cpp \
     Ui/externalmasterview.cpp \
     Ui/mainwindow.cpp \
-    main.cpp\
-    miprodebug.cpp \
-    Animation/minagrid.cpp
+    main.cpp
 
 
 HEADERS  += \
-    Animation/minaballs.h \
-    Animation/minabarsfromsides.h \
-    Animation/minacurve.h \
-    Animation/minadebug.h \
-    Animation/minaexpandingobjects.h \
-    Animation/minafallingobjects.h \
-    Animation/minaflash.h \
-    Animation/minaflashbars.h \
-    Animation/minagradient.h \
-    Animation/minaimage.h \
-    Animation/minaplasma.h \
-    Animation/minarainbowoil.h \
-    Animation/minarandompixels.h \
-    Animation/minarotatingbars.h \    
-    Animation/minastars.h \
-    Animation/minatext.h \
-    Animation/minavibration.h \
-    Animation/minawaveform.h \
-    Core/Midi/midi.h \
-    Core/Midi/midicontrol.h \
-    Core/Midi/midicontrollablelist.h \
-    Core/Midi/midicontrollableparameter.h \
-    Core/Midi/midicontrollablereal.h \
-    Core/Midi/midiinterface.h \
-    Core/Midi/midimapper.h \
-    Core/Midi/midimapping.h \
-    Core/Property/minoitemizedproperty.h \
-    Core/Property/minoproperty.h \
-    Core/Property/minopropertybeat.h \
-    Core/Property/minopropertycolor.h \
-    Core/Property/minopropertyeasingcurve.h \
-    Core/Property/minopropertyfilename.h \
-    Core/Property/minopropertyreal.h \
-    Core/Property/minopropertytext.h \
-    Core/easingcurvedreal.h \
-    Core/ledmatrix.h \
-    Core/minoanimation.h \
-    Core/minoanimationgroup.h \
-    Core/minoclocksource.h \
-    Core/minocontrol.h \
-    Core/minoinstrumentedanimation.h \
-    Core/minomaster.h \
-    Core/minomastermidimapper.h \
-    Core/minopersistentobject.h \
-    Core/minopersistentobjectfactory.h \
-    Core/minoprogram.h \
-    Core/minoprogrambank.h \
-    Core/minopropertymidichannel.h \
-    Core/minotor.h \
-    Core/minotrigger.h \
     Ui/Widget/uianimation.h \
     Ui/Widget/uianimationdescription.h \
     Ui/Widget/uianimationgroup.h \
@@ -149,25 +51,18 @@ HEADERS  += \
     Ui/Widget/uimastercontrol.h \
     Ui/Widget/uimidicontrollableparameter.h \
     Ui/Widget/uimidiinterface.h \
+    Ui/Widget/uiperformancehud.h \
+    Ui/Widget/uipreviewcompositor.h \
     Ui/Widget/uiprogram.h \
     Ui/Widget/uiprogrambank.h \
     Ui/Widget/uiprogrameditor.h \
     Ui/Widget/uiprogramview.h \
+    Ui/Widget/uiupdatecoalescer.h \
     Ui/configdialog.h \
     Ui/externalmasterview.h \
-    Ui/mainwindow.h \
-    miprobnzichru.h \
-    miprodebug.h \
-    mipromatrix.h \
-    miprosecondlives.h \
-    miprowaves.h \
-    Animation/minagrid.h
+    Ui/mainwindow.h
 
 INCLUDEPATH += \
-    Animation \
-    Core \
-    Core/Midi \
-    Core/Property \
     Ui \
     Ui/Widget
 
@@ -176,20 +71,6 @@ FORMS    += \
     Ui/configdialog.ui \
     Ui/externalmasterview.ui
 
-packagesExist(rtmidi) {
-  PKGCONFIG += rtmidi
-} else {
-  include(libraries/rtmidi/rtmidi.pri)
-}
-
-unix {
-  CONFIG += link_pkgconfig
-  CONFIG += extserialport
-} else {
-  include(libraries/qextserialport/src/qextserialport.pri)
-}
-
-
 RESOURCES += \
     minotor.qrc
 
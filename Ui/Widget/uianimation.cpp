@@ -38,6 +38,7 @@
 #include "minoprogram.h"
 #include "minoanimationgroup.h"
 #include "minotor.h"
+#include "minothumbnailservice.h"
 
 UiAnimation::UiAnimation(MinoAnimation *animation, QWidget *parent) :
     QGroupBox(parent),
@@ -155,6 +156,7 @@ UiAnimation::UiAnimation(MinoAnimation *animation, QWidget *parent) :
 
     lContent->addStretch(1);
     connect(animation, SIGNAL(destroyed()), this, SLOT(deleteLater()));
+    connect(MinoThumbnailService::service(), SIGNAL(thumbnailReady(QObject*,QImage)), this, SLOT(thumbnailReady(QObject*,QImage)));
 
     this->setAttribute(Qt::WA_NoMousePropagation, true);
 }
@@ -215,7 +217,11 @@ template <typename T> T UiAnimation::findParent()
 
 void UiAnimation::takeAShot()
 {
-    QPixmap *pixmap = Minotor::minotor()->graphicsItemToPixmap(_animation->graphicItem());
-    _tAnimation->setPixmap(pixmap->scaled(60,40,Qt::KeepAspectRatio,Qt::SmoothTransformation));
-    delete pixmap;
+    MinoThumbnailService::service()->request(_animation, _animation->graphicItem(), QSize(60,40));
+}
+
+void UiAnimation::thumbnailReady(QObject *owner, const QImage &thumbnail)
+{
+    if(owner == _animation)
+        _tAnimation->setPixmap(QPixmap::fromImage(thumbnail));
 }
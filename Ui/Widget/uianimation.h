@@ -51,6 +51,9 @@ protected slots:
 
     void takeAShot();
 
+private slots:
+    void thumbnailReady(QObject *owner, const QImage &thumbnail);
+
 };
 
 #endif // UIANIMATION_H
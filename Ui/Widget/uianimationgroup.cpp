@@ -28,6 +28,7 @@
 
 #include "minoprogram.h"
 #include "minotor.h"
+#include "minothumbnailservice.h"
 #include "uianimation.h"
 #include "uiprogram.h"
 #include "uiprogrambank.h"
@@ -78,8 +79,20 @@ UiAnimationGroup::UiAnimationGroup(MinoAnimationGroup *group, QWidget *parent) :
     pbScreenshot->setMinimumSize(14,14);
     pbScreenshot->setMaximumSize(14,14);
     connect(pbScreenshot, SIGNAL(clicked()), this, SLOT(takeAShot()));
+    connect(MinoThumbnailService::service(), SIGNAL(thumbnailReady(QObject*,QImage)), this, SLOT(thumbnailReady(QObject*,QImage)));
     lTools->addWidget(pbScreenshot);
 
+    //Blend mode button (cycles through modes)
+    _pbBlendMode = new QPushButton(wTools);
+    _pbBlendMode->setObjectName("tiny");
+    _pbBlendMode->setFocusPolicy(Qt::NoFocus);
+    _pbBlendMode->setMinimumSize(14,14);
+    _pbBlendMode->setMaximumSize(14,14);
+    connect(_pbBlendMode, SIGNAL(clicked()), this, SLOT(nextBlendMode()));
+    connect(_group, SIGNAL(blendModeChanged(int)), this, SLOT(updateBlendMode(int)));
+    updateBlendMode(_group->blendMode());
+    lTools->addWidget(_pbBlendMode);
+
     lTools->addStretch();
 
     //Enable button
@@ -275,8 +288,27 @@ void UiAnimationGroup::enable(const bool on)
 
 void UiAnimationGroup::takeAShot()
 {
-    QPixmap *pixmap = Minotor::minotor()->graphicsItemToPixmap(_group->itemGroup());
-    _group->setScreenshot(*pixmap);
-    _pbEnable->setIcon(QIcon(_group->screenshot().scaled(60,40,Qt::KeepAspectRatio,Qt::SmoothTransformation)));
-    delete pixmap;
+    MinoThumbnailService::service()->request(_group, _group->itemGroup(), QSize(60,40));
+}
+
+void UiAnimationGroup::thumbnailReady(QObject *owner, const QImage &thumbnail)
+{
+    if(owner == _group)
+    {
+        _group->setScreenshot(QPixmap::fromImage(thumbnail));
+        _pbEnable->setIcon(QIcon(_group->screenshot()));
+    }
+}
+
+void UiAnimationGroup::nextBlendMode()
+{
+    _group->setBlendMode((_group->blendMode() + 1) % (MinoCompositor::Max + 1));
+}
+
+void UiAnimationGroup::updateBlendMode(int mode)
+{
+    static const char *labels[] = { "N", "+", "S", "x", "M" };
+    static const char *names[] = { "normal", "add", "screen", "multiply", "max" };
+    _pbBlendMode->setText(labels[mode]);
+    _pbBlendMode->setToolTip(QString("Blend mode: %1 (click to change)").arg(names[mode]));
 }
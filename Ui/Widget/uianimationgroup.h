@@ -50,6 +50,7 @@ private:
     QHBoxLayout *_lAnimations;
     QWidget *_wAnimations;
     QPushButton *_pbEnable;
+    QPushButton *_pbBlendMode;
     bool _expanded;
 signals:
     void animationMoved(QObject* uiAnimation, int programId, int groupId);
@@ -60,6 +61,9 @@ protected slots:
     void mousePressEvent(QMouseEvent *event);
     void takeAShot();
 private slots:
+    void thumbnailReady(QObject *owner, const QImage &thumbnail);
+    void nextBlendMode();
+    void updateBlendMode(int mode);
     void addAnimation(QObject *animation);
     void moveAnimation(QObject *animation);
 
@@ -28,6 +28,7 @@
 
 #include "midicontrollableparameter.h"
 #include "midicontrollablelist.h"
+#include "uiupdatecoalescer.h"
 
 UiKnob::UiKnob(MidiControllableParameter *parameter, QWidget *parent):
     QWidget(parent),
@@ -214,7 +215,8 @@ void UiKnob::_setValue(qreal value)
 void UiKnob::setValueFromMidi(quint8 value)
 {
     _value = ((qreal)value/127.0*(_maxValue-_minValue))+_minValue;
-    update();
+    // MIDI may send many values per frame: repaint once per display refresh
+    UiUpdateCoalescer::coalescer()->schedule(this);
 }
 
 void UiKnob::mousePressEvent(QMouseEvent *e)
@@ -30,6 +30,7 @@
 #include <QDoubleSpinBox>
 
 #include "minotor.h"
+#include "midicontrollablelist.h"
 
 #include "uiprogramview.h"
 #include "uimidicontrollableparameter.h"
@@ -127,6 +128,13 @@ UiMaster::UiMaster(MinoMaster *master, QWidget *parent) :
         UiMidiControllableParameter *dBrightness = new UiMidiControllableParameter(mpBrightness, wTools);
         lTools->addWidget(dBrightness);
     }
+    // Transition used when programs are changed
+    foreach(const QString &name, QStringList() << "master-transition" << "master-transition-length")
+    {
+        MidiControllableList *mclTransition = _master->findChild<MidiControllableList*>(name);
+        Q_ASSERT(mclTransition);
+        lTools->addWidget(new UiMidiControllableParameter(mclTransition, wTools));
+    }
     lTools->addStretch();
 
     lMasterView->addStretch();
@@ -32,12 +32,14 @@
 #include "minoitemizedproperty.h"
 
 #include "uiknob.h"
+#include "uiupdatecoalescer.h"
 
 UiMidiControllableParameter::UiMidiControllableParameter(MidiControllableParameter *parameter, QWidget *parent, bool editorMode) :
     QWidget(parent),
     _midiLearnMode(false),
     _midiControlled(false),
-    _parameter(parameter)
+    _parameter(parameter),
+    _tItemName(NULL)
 {
     this->setMinimumWidth(50);
     this->setMinimumHeight(50);
@@ -72,11 +74,11 @@ UiMidiControllableParameter::UiMidiControllableParameter(MidiControllableParamet
             QString itemName = "no item";
             if(mcl->currentItem())
                 itemName = mcl->currentItem()->name();
-            QLabel *tItemName = new QLabel(itemName, wTop);
-            tItemName->setObjectName("dialinfo");
-            tItemName->setAlignment(Qt::AlignHCenter);
-            connect(mcl, SIGNAL(itemChanged(QString)), tItemName, SLOT(setText(QString)));
-            lTop->addWidget(tItemName);
+            _tItemName = new QLabel(itemName, wTop);
+            _tItemName->setObjectName("dialinfo");
+            _tItemName->setAlignment(Qt::AlignHCenter);
+            connect(mcl, SIGNAL(itemChanged(QString)), this, SLOT(scheduleItemNameUpdate()));
+            lTop->addWidget(_tItemName);
             lTop->addStretch();
 
             QPushButton *pbOnMaster = new QPushButton(wTop);
@@ -90,11 +92,11 @@ UiMidiControllableParameter::UiMidiControllableParameter(MidiControllableParamet
         else
         {
             lTop->addStretch();
-            QLabel *tItemName = new QLabel(mcl->currentItem()->name(), wTop);
-            tItemName->setObjectName("dialinfo");
-            tItemName->setAlignment(Qt::AlignHCenter);
-            connect(mcl, SIGNAL(itemChanged(QString)), tItemName, SLOT(setText(QString)));
-            lTop->addWidget(tItemName);
+            _tItemName = new QLabel(mcl->currentItem()->name(), wTop);
+            _tItemName->setObjectName("dialinfo");
+            _tItemName->setAlignment(Qt::AlignHCenter);
+            connect(mcl, SIGNAL(itemChanged(QString)), this, SLOT(scheduleItemNameUpdate()));
+            lTop->addWidget(_tItemName);
             lTop->addStretch();
         }
     }
@@ -212,3 +214,16 @@ void UiMidiControllableParameter::setMidiLearnMode(bool on)
     _midiLearnMode = on;
     update();
 }
+
+void UiMidiControllableParameter::scheduleItemNameUpdate()
+{
+    // Label relayout is expensive: only last item of a MIDI sweep is displayed
+    UiUpdateCoalescer::coalescer()->schedule(this, "updateItemName");
+}
+
+void UiMidiControllableParameter::updateItemName()
+{
+    MidiControllableList* mcl = dynamic_cast<MidiControllableList*>(_parameter);
+    if(mcl && mcl->currentItem())
+        _tItemName->setText(mcl->currentItem()->name());
+}
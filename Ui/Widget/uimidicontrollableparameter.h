@@ -25,6 +25,8 @@
 
 #include "midicontrollableparameter.h"
 
+class QLabel;
+
 class UiMidiControllableParameter : public QWidget
 {
     Q_OBJECT
@@ -47,12 +49,15 @@ protected:
 
 private:
     MidiControllableParameter *_parameter;
+    QLabel *_tItemName;
 signals:
     
 public slots:
     
 private slots:
     void togglePropertyToMaster(bool on);
+    void scheduleItemNameUpdate();
+    void updateItemName();
 };
 
 #endif // UIMIDICONTROLLABLEPARAMETER
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "uiperformancehud.h"
+
+#include <QEvent>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QTimerEvent>
+
+#include "uiupdatecoalescer.h"
+
+// Statistics are refreshed twice a second: HUD should not cost more than what it measures
+#define UIPERFORMANCEHUD_REFRESH_MS 500
+
+UiPerformanceHud::UiPerformanceHud(QWidget *parent) :
+    QWidget(parent)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPointSize(8);
+    setFont(font);
+
+    // Follow parent's geometry
+    parent->installEventFilter(this);
+    hide();
+}
+
+void UiPerformanceHud::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    refresh();
+    _refreshTimer.start(UIPERFORMANCEHUD_REFRESH_MS, this);
+}
+
+void UiPerformanceHud::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    _refreshTimer.stop();
+}
+
+void UiPerformanceHud::timerEvent(QTimerEvent *event)
+{
+    if(event->timerId() == _refreshTimer.timerId())
+    {
+        refresh();
+    }
+    else
+    {
+        QWidget::timerEvent(event);
+    }
+}
+
+bool UiPerformanceHud::eventFilter(QObject *object, QEvent *event)
+{
+    if((object == parent()) && (event->type() == QEvent::Resize))
+    {
+        reposition();
+    }
+    return QWidget::eventFilter(object, event);
+}
+
+void UiPerformanceHud::refresh()
+{
+    _stats = MinoProfiler::profiler()->stats();
+    reposition();
+    raise();
+    update();
+}
+
+void UiPerformanceHud::reposition()
+{
+    const QFontMetrics fm(font());
+    const int w = fm.width(QString(80, 'M')) / 2 + 12;
+    const int h = (_stats.count() + 3) * fm.height() + 8;
+    const QWidget *parent = parentWidget();
+    setGeometry(parent->width() - w - 8, 8, w, qMin(h, parent->height() - 16));
+}
+
+void UiPerformanceHud::paintEvent(QPaintEvent *event)
+{
+    (void)event;
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(0, 0, 0, 192));
+
+    const QFontMetrics fm(font());
+    int y = 4 + fm.ascent();
+    painter.setPen(Qt::white);
+    painter.drawText(6, y, QString("%1 %2 %3 %4 %5")
+                     .arg("stage", -32)
+                     .arg("min", 7).arg("avg", 7).arg("p99", 7)
+                     .arg("miss", 6));
+    y += fm.height();
+
+    const qint64 deadline = MinoProfiler::profiler()->deadline();
+    foreach(const MinoProfilerStats &stats, _stats)
+    {
+        // Highlight stages close to frame deadline
+        if(deadline && (stats.p99 > deadline))
+            painter.setPen(Qt::red);
+        else if(deadline && (stats.p99 > deadline/2))
+            painter.setPen(Qt::yellow);
+        else
+            painter.setPen(Qt::white);
+
+        // Durations are displayed in milliseconds
+        painter.drawText(6, y, QString("%1 %2 %3 %4 %5")
+                         .arg(stats.name.left(32), -32)
+                         .arg((qreal)stats.min / 1000000.0, 7, 'f', 3)
+                         .arg((qreal)stats.avg / 1000000.0, 7, 'f', 3)
+                         .arg((qreal)stats.p99 / 1000000.0, 7, 'f', 3)
+                         .arg(stats.deadlineMisses, 6));
+        y += fm.height();
+    }
+
+    painter.setPen(Qt::gray);
+    painter.drawText(6, y, QString("deadline %1 ms, dropped %2")
+                     .arg((qreal)deadline / 1000000.0, 0, 'f', 3)
+                     .arg(MinoProfiler::profiler()->droppedSamples()));
+    y += fm.height();
+
+    const UiUpdateCoalescer *coalescer = UiUpdateCoalescer::coalescer();
+    painter.drawText(6, y, QString("UI updates %1, coalesced %2")
+                     .arg(coalescer->flushedUpdates())
+                     .arg(coalescer->coalescedUpdates()));
+}
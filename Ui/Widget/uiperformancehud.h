@@ -0,0 +1,52 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UIPERFORMANCEHUD_H
+#define UIPERFORMANCEHUD_H
+
+#include <QWidget>
+#include <QBasicTimer>
+
+#include "minoprofiler.h"
+
+// Overlay showing MinoProfiler statistics on top of its parent widget
+class UiPerformanceHud : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit UiPerformanceHud(QWidget *parent);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
+    void timerEvent(QTimerEvent *event);
+    bool eventFilter(QObject *object, QEvent *event);
+
+private:
+    QBasicTimer _refreshTimer;
+    QList<MinoProfilerStats> _stats;
+
+    void refresh();
+    void reposition();
+};
+
+#endif // UIPERFORMANCEHUD_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "uipreviewcompositor.h"
+
+#include <QPainter>
+#include <QTimerEvent>
+
+#include "uiprogramview.h"
+#include "minotor.h"
+
+// Previews don't need to follow every rendered frame
+#define UIPREVIEWCOMPOSITOR_MAX_FPS 25
+
+// Cache cost unit is a grid overlay (a few view sizes are in use at a time)
+#define UIPREVIEWCOMPOSITOR_GRID_CACHE_SIZE 8
+
+UiPreviewCompositor::UiPreviewCompositor() :
+    QObject(NULL),
+    _gridOverlays(UIPREVIEWCOMPOSITOR_GRID_CACHE_SIZE)
+{
+    connect(Minotor::minotor(), SIGNAL(rendererSizeChanged()), this, SLOT(clearGridOverlays()));
+}
+
+void UiPreviewCompositor::addView(UiProgramView *view)
+{
+    Q_ASSERT(!_views.contains(view));
+    _views.append(view);
+    if(!_refreshTimer.isActive())
+        _refreshTimer.start(1000 / UIPREVIEWCOMPOSITOR_MAX_FPS, this);
+}
+
+void UiPreviewCompositor::removeView(UiProgramView *view)
+{
+    _views.removeAll(view);
+    if(_views.isEmpty())
+        _refreshTimer.stop();
+}
+
+void UiPreviewCompositor::timerEvent(QTimerEvent *event)
+{
+    if(event->timerId() != _refreshTimer.timerId())
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    foreach(UiProgramView *view, _views)
+    {
+        // visibleRegion() is empty when view is clipped out by a scroll area or obscured by siblings
+        if(view->isDirty() && view->isVisible() && !view->visibleRegion().isEmpty())
+            view->update();
+    }
+}
+
+QPixmap UiPreviewCompositor::gridOverlay(const QSize &size)
+{
+    const quint32 key = (quint32(size.width()) << 16) | quint32(size.height() & 0xffff);
+    QPixmap *overlay = _gridOverlays.object(key);
+    if(!overlay)
+    {
+        const QRect rect = Minotor::minotor()->displayRect();
+        const qreal stepX = (qreal)size.width() / rect.width();
+        const qreal stepY = (qreal)size.height() / rect.height();
+
+        QVector<QLine> gridLines;
+        for (int x = 1; x < rect.width(); x++)
+        {
+            int pos = x * stepX;
+            gridLines.append(QLine(pos,0,pos,size.height()));
+        }
+        for (int y = 1; y < rect.height(); y++)
+        {
+            int pos = y * stepY;
+            gridLines.append(QLine(0,pos,size.width(),pos));
+        }
+
+        overlay = new QPixmap(size);
+        overlay->fill(Qt::transparent);
+        QPainter painter(overlay);
+        QPen pen;
+        pen.setWidthF(qMin(stepX, stepY)*0.25);
+        pen.setColor(Qt::black);
+        painter.setPen(pen);
+        painter.drawLines(gridLines);
+        painter.end();
+
+        _gridOverlays.insert(key, overlay);
+    }
+    return *overlay;
+}
+
+void UiPreviewCompositor::clearGridOverlays()
+{
+    _gridOverlays.clear();
+}
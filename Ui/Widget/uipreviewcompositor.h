@@ -0,0 +1,63 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UIPREVIEWCOMPOSITOR_H
+#define UIPREVIEWCOMPOSITOR_H
+
+#include <QObject>
+#include <QBasicTimer>
+#include <QCache>
+#include <QPixmap>
+
+class UiProgramView;
+
+// Repaints all program previews from a single timer:
+//  - views are only marked dirty when their program is animated,
+//  - dirty views are repainted at most UIPREVIEWCOMPOSITOR_MAX_FPS times per second,
+//  - views hidden, scrolled out or covered by other widgets are skipped.
+// Grid overlays are cached per view size and shared between views.
+class UiPreviewCompositor : public QObject
+{
+    Q_OBJECT
+public:
+    static UiPreviewCompositor *compositor() { static UiPreviewCompositor *compositor = new UiPreviewCompositor(); return compositor; }
+
+    void addView(UiProgramView *view);
+    void removeView(UiProgramView *view);
+
+    // Transparent pixmap with black lines between LEDs of a preview of this size
+    QPixmap gridOverlay(const QSize &size);
+
+protected:
+    void timerEvent(QTimerEvent *event);
+
+private slots:
+    void clearGridOverlays();
+
+private:
+    explicit UiPreviewCompositor();
+
+    QBasicTimer _refreshTimer;
+    QList<UiProgramView*> _views;
+    QCache<quint32, QPixmap> _gridOverlays;
+};
+
+#endif // UIPREVIEWCOMPOSITOR_H
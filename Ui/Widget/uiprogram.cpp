@@ -227,12 +227,10 @@ void UiProgram::exportProgram()
 {
     QString dataPath = Minotor::dataPath();
     QString fileName = QFileDialog::getSaveFileName(this, tr("Save File"), dataPath,tr(" (*.mpr)"));
-    if(QFile::exists(fileName))
+    if(!fileName.isEmpty())
     {
-        QFile::remove(fileName);
+        _program->minotor()->saveToFile(_program, fileName);
     }
-    QSettings parser(fileName, QSettings::IniFormat);
-    _program->minotor()->save(_program, &parser);
 }
 
 void UiProgram::setHighlight(bool on)
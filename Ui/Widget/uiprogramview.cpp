@@ -21,48 +21,38 @@
 #include "uiprogramview.h"
 
 #include <QPainter>
-#include <QLine>
 #include <QDebug>
 
-#include "minotor.h"
+#include "uipreviewcompositor.h"
 
 UiProgramView::UiProgramView(MinoProgram *program, QWidget *parent) :
     QWidget(parent),
     _program(NULL),
-    _gridStepMin(0)
+    _dirty(true),
+    _viewing(false)
 {
     // Optimize widget's repaint
     setAttribute(Qt::WA_OpaquePaintEvent);
 
     setProgram(program);
+    UiPreviewCompositor::compositor()->addView(this);
 }
 
-void UiProgramView::resizeEvent(QResizeEvent *)
+UiProgramView::~UiProgramView()
 {
-    const QRect rect = Minotor::minotor()->displayRect();
-    _gridLines.clear();
-    const qreal stepX = (qreal)width() / rect.width();
-    const qreal stepY = (qreal)height() / rect.height();
-    for (int x = 1; x < rect.width(); x++)
-    {
-        int pos = x * stepX;
-        _gridLines.append(QLine(pos,0,pos,height()));
-    }
-    for (int y = 1; y < rect.height(); y++)
-    {
-        int pos = y * stepY;
-        _gridLines.append(QLine(0,pos,width(),pos));
-    }
-    _gridStepMin = qMin(stepX, stepY);
+    if(_program && _viewing)
+        _program->removeViewer();
+    UiPreviewCompositor::compositor()->removeView(this);
 }
 
 // This function produce draw the widget content
-//   It draw the render content (scaled to fit to widget size) and decorates it using some vertical and horizotal black lines
+//   It draw the render content (scaled to fit to widget size) and decorates it with the grid overlay
 void UiProgramView::paintEvent(QPaintEvent *event)
 {
     // event is not used
     (void)event;
 
+    _dirty = false;
     if(!_program)
         return;
 
@@ -72,14 +62,33 @@ void UiProgramView::paintEvent(QPaintEvent *event)
     // Construct a painter to draw into this widget
     QPainter painter(this);
 
+    // Nearest-neighbour upscaling: each LED is a plain block of pixels
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
     painter.drawImage(rect(), *rendering, rendering->rect());
 
-    QPen pen;
-    pen.setWidthF(_gridStepMin*0.25);
-    pen.setColor(Qt::black);
-    painter.setPen(pen);
+    painter.drawPixmap(0, 0, UiPreviewCompositor::compositor()->gridOverlay(size()));
+}
+
+void UiProgramView::showEvent(QShowEvent *event)
+{
+    (void)event;
+    if(!_viewing)
+    {
+        _viewing = true;
+        if(_program)
+            _program->addViewer();
+    }
+}
 
-    painter.drawLines(_gridLines);
+void UiProgramView::hideEvent(QHideEvent *event)
+{
+    (void)event;
+    if(_viewing)
+    {
+        _viewing = false;
+        if(_program)
+            _program->removeViewer();
+    }
 }
 
 int UiProgramView::heightForWidth( int width ) const
@@ -91,18 +100,28 @@ void UiProgramView::setProgram(MinoProgram *program)
 {
     if(_program)
     {
-        disconnect(_program, SIGNAL(animated()), this, SLOT(update()));
+        disconnect(_program, SIGNAL(animated()), this, SLOT(markDirty()));
         disconnect(_program, SIGNAL(destroyed()), this, SLOT(clear()));
+        if(_viewing)
+            _program->removeViewer();
     }
     if(program)
     {
-        connect(program, SIGNAL(animated()), this, SLOT(update()));
+        connect(program, SIGNAL(animated()), this, SLOT(markDirty()));
         connect(program, SIGNAL(destroyed()), this, SLOT(clear()));
+        if(_viewing)
+            program->addViewer();
     }
     _program = program;
+    _dirty = true;
 }
 
 void UiProgramView::clear()
 {
     _program = NULL;
 }
+
+void UiProgramView::markDirty()
+{
+    _dirty = true;
+}
@@ -30,20 +30,27 @@ class UiProgramView : public QWidget
     Q_OBJECT
 public:
     explicit UiProgramView(MinoProgram *program, QWidget *parent);
+    ~UiProgramView();
+
+    // Program has been animated since last paint (repaint is scheduled by UiPreviewCompositor)
+    bool isDirty() const { return _dirty; }
 signals:
 protected:
     void paintEvent(QPaintEvent *event);
-    void resizeEvent(QResizeEvent *);
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
 
     virtual int heightForWidth( int width ) const;
 public slots:
     void setProgram(MinoProgram *program);
 protected slots:
     void clear();
+    void markDirty();
 private:
     MinoProgram *_program;
-    QVector<QLine> _gridLines;
-    qreal _gridStepMin;
+    bool _dirty;
+    // Widget is shown: it is registered as a viewer of _program
+    bool _viewing;
 
 };
 
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "uiupdatecoalescer.h"
+
+#include <QTimerEvent>
+
+#if QT_VERSION >= 0x050000
+#include <QGuiApplication>
+#include <QScreen>
+#endif
+
+// Used when display refresh rate is unknown
+#define UIUPDATECOALESCER_DEFAULT_REFRESH_RATE 60
+
+UiUpdateCoalescer::UiUpdateCoalescer() :
+    QObject(NULL),
+    _refreshInterval(1000 / UIUPDATECOALESCER_DEFAULT_REFRESH_RATE),
+    _flushedUpdates(0),
+    _coalescedUpdates(0)
+{
+#if QT_VERSION >= 0x050000
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    if(screen && (screen->refreshRate() > 1.0))
+        _refreshInterval = qMax(1, (int)(1000.0 / screen->refreshRate()));
+#endif
+}
+
+void UiUpdateCoalescer::schedule(QObject *receiver, const char *slot)
+{
+    Q_ASSERT(receiver);
+    const Update update(receiver, QByteArray(slot));
+    if(_pendingUpdates.contains(update))
+    {
+        _coalescedUpdates++;
+        return;
+    }
+    // Receiver may be destroyed before refresh
+    connect(receiver, SIGNAL(destroyed(QObject*)), this, SLOT(receiverDestroyed(QObject*)), Qt::UniqueConnection);
+    _pendingUpdates.append(update);
+    if(!_refreshTimer.isActive())
+        _refreshTimer.start(_refreshInterval, this);
+}
+
+void UiUpdateCoalescer::timerEvent(QTimerEvent *event)
+{
+    if(event->timerId() != _refreshTimer.timerId())
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    _refreshTimer.stop();
+    // Slots may schedule new updates: they will be processed on next refresh
+    _flushingUpdates = _pendingUpdates;
+    _pendingUpdates.clear();
+    while(!_flushingUpdates.isEmpty())
+    {
+        const Update update = _flushingUpdates.takeFirst();
+        QMetaObject::invokeMethod(update.first, update.second.constData());
+        _flushedUpdates++;
+    }
+}
+
+void UiUpdateCoalescer::receiverDestroyed(QObject *receiver)
+{
+    for(int i=_pendingUpdates.count()-1; i>=0; i--)
+    {
+        if(_pendingUpdates.at(i).first == receiver)
+            _pendingUpdates.removeAt(i);
+    }
+    for(int i=_flushingUpdates.count()-1; i>=0; i--)
+    {
+        if(_flushingUpdates.at(i).first == receiver)
+            _flushingUpdates.removeAt(i);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2012, 2013 Gauthier Legrand
+ * Copyright 2012, 2013 Romuald Conty
+ * 
+ * This file is part of Minotor.
+ * 
+ * Minotor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Minotor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Minotor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UIUPDATECOALESCER_H
+#define UIUPDATECOALESCER_H
+
+#include <QObject>
+#include <QBasicTimer>
+#include <QList>
+#include <QPair>
+#include <QByteArray>
+
+// Defers widget refreshes triggered by parameter changes (ie. MIDI fader sweeps):
+// a slot scheduled several times before next display refresh is only invoked once.
+class UiUpdateCoalescer : public QObject
+{
+    Q_OBJECT
+public:
+    static UiUpdateCoalescer *coalescer() { static UiUpdateCoalescer *coalescer = new UiUpdateCoalescer(); return coalescer; }
+
+    // Invoke receiver's slot (without argument) on next refresh
+    void schedule(QObject *receiver, const char *slot = "update");
+
+    // Statistics
+    quint64 flushedUpdates() const { return _flushedUpdates; }
+    quint64 coalescedUpdates() const { return _coalescedUpdates; }
+
+protected:
+    void timerEvent(QTimerEvent *event);
+
+private slots:
+    void receiverDestroyed(QObject *receiver);
+
+private:
+    explicit UiUpdateCoalescer();
+
+    QBasicTimer _refreshTimer;
+    int _refreshInterval;
+
+    typedef QPair<QObject*, QByteArray> Update;
+    QList<Update> _pendingUpdates;
+    // Updates being invoked (receivers may be destroyed meanwhile)
+    QList<Update> _flushingUpdates;
+
+    quint64 _flushedUpdates;
+    quint64 _coalescedUpdates;
+};
+
+#endif // UIUPDATECOALESCER_H
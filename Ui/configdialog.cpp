@@ -67,7 +67,6 @@ ConfigDialog::ConfigDialog(QWidget *parent) :
     connect(ui->sbPanelPixelsInY, SIGNAL(valueChanged(int)), this, SLOT(refreshMatrixConfig()));
 
     // Hack to refresh list at startup
-    _midiAutoRefreshTimer = new QTimer(this);
     updateGeneralTab();
     updateMidiTab();
     updateMidiMappingTab();
@@ -164,7 +163,6 @@ void ConfigDialog::addMidiControl(const int row, const quint8 channel, const qui
 void ConfigDialog::on_tabWidget_currentChanged(int index)
 {
     disconnect(Minotor::minotor()->midi(), SIGNAL(controlChanged(int,quint8,quint8,quint8)), this, SLOT(midiControlChanged(int,quint8,quint8,quint8)));
-    _midiAutoRefreshTimer->stop();
 
     switch(index)
     {
@@ -211,12 +209,11 @@ void ConfigDialog::updateMidiInterfaces()
 void ConfigDialog::updateMidiTab()
 {
     Midi *midi = Minotor::minotor()->midi();
-    connect(_midiAutoRefreshTimer, SIGNAL(timeout()), midi, SLOT(scanMidiInterfaces()), Qt::UniqueConnection);
+    // Interfaces list is refreshed when devices are plugged/unplugged
     connect(midi, SIGNAL(updated()), this, SLOT(updateMidiInterfaces()), Qt::UniqueConnection);
-    // Scan new interfaces
-    midi->scanMidiInterfaces();
+    // Scan new interfaces (some platforms have no hot-plug notification)
+    midi->scanMidiInterfacesAsync();
     updateMidiInterfaces();
-    _midiAutoRefreshTimer->start(500);
 }
 
 void ConfigDialog::loadMidiMappingFiles(QComboBox *cb)
@@ -465,6 +462,9 @@ void ConfigDialog::updateGeneralTab()
     ui->sbPanelsInY->setValue(matrixSize.height());
     ui->sbPanelPixelsInX->setValue(panelSize.width());
     ui->sbPanelPixelsInY->setValue(panelSize.height());
+    // Combobox items are 1x, 2x and 4x
+    const int supersampling = Minotor::minotor()->supersampling();
+    ui->cbSupersampling->setCurrentIndex((supersampling == 4) ? 2 : supersampling - 1);
 }
 
 void ConfigDialog::on_buttonBox_clicked(QAbstractButton *button)
@@ -474,6 +474,7 @@ void ConfigDialog::on_buttonBox_clicked(QAbstractButton *button)
         Minotor::minotor()->setRendererSize(QSize(ui->sbSceneWidth->value(), ui->sbSceneHeight->value()));
         Minotor::minotor()->setMatrixSize(QSize(ui->sbPanelsInX->value(), ui->sbPanelsInY->value()));
         Minotor::minotor()->setPanelSize(QSize(ui->sbPanelPixelsInX->value(), ui->sbPanelPixelsInY->value()));
+        Minotor::minotor()->setSupersampling(1 << ui->cbSupersampling->currentIndex());
         Minotor::minotor()->saveSettings();
     }
 }
@@ -78,7 +78,6 @@ private:
     void updateMidiMappingTab();
     void updateSerialTab();
 
-    QTimer *_midiAutoRefreshTimer;
     void addMidiMappingEntry(QFileInfo file, QComboBox *cb);
     void addMidiMappingEditorEntry(QFileInfo file);
     void saveMidiMappingFile(QString file);
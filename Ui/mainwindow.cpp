@@ -47,6 +47,8 @@
 #include "minoanimation.h"
 #include "minoproperty.h"
 #include "minoprogram.h"
+#include "minotracerecorder.h"
+#include "minoprogrambankloader.h"
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -68,6 +70,9 @@ MainWindow::MainWindow(QWidget *parent) :
     _externalMasterView = new ExternalMasterView(this);
     _externalMasterView->setVisible(false);
 
+    // Frame timings overlay
+    _uiPerformanceHud = new UiPerformanceHud(ui->centralWidget);
+
     QVBoxLayout *lCentralWidget = new QVBoxLayout(ui->centralWidget);
     lCentralWidget->setSpacing(5);
     lCentralWidget->setMargin(0);
@@ -355,18 +360,29 @@ void MainWindow::on_actionQuit_triggered()
 void MainWindow::on_actionLoad_triggered()
 {
     QString dataPath = Minotor::dataPath();
-    _programBankFileName = QFileDialog::getOpenFileName(this, tr("Load File"), dataPath,tr("Program (*.mpb)"));
-    QSettings parser(_programBankFileName, QSettings::IniFormat);
-    _minotor->load(&parser);
+    const QString fileName = QFileDialog::getOpenFileName(this, tr("Load File"), dataPath,tr("Program (*.mpb)"));
+    if(fileName.isEmpty())
+        return;
+    // Binary banks are loaded in background, legacy INI ones synchronously
+    switch(_minotor->programBankLoader()->load(fileName))
+    {
+    case MinoProgramBankLoader::Loading:
+        break;
+    case MinoProgramBankLoader::Busy:
+        QMessageBox::warning(this, tr("Load File"), tr("A program bank is already being loaded"));
+        return;
+    case MinoProgramBankLoader::NotBinary:
+        _minotor->loadFromFile(fileName);
+        break;
+    }
+    _programBankFileName = fileName;
 }
 
 void MainWindow::on_actionSave_triggered()
 {
     if (!_programBankFileName.isEmpty())
     {
-        QFile::remove(_programBankFileName);
-        QSettings parser(_programBankFileName, QSettings::IniFormat);
-        _minotor->save(_minotor->programBank(), &parser);
+        _minotor->saveToFile(_minotor->programBank(), _programBankFileName);
     }
     else
     {
@@ -378,12 +394,21 @@ void MainWindow::on_actionSaveAs_triggered()
 {
     QString dataPath = Minotor::dataPath();
     _programBankFileName = QFileDialog::getSaveFileName(this, tr("Save File"), dataPath,tr(" (*.mpb)"));
-    if(QFile::exists(_programBankFileName))
+    if(!_programBankFileName.isEmpty())
+    {
+        _minotor->saveToFile(_minotor->programBank(), _programBankFileName);
+    }
+}
+
+void MainWindow::on_actionExportIni_triggered()
+{
+    // INI export keeps banks readable by previous Minotor releases
+    QString dataPath = Minotor::dataPath();
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export as INI"), dataPath,tr(" (*.mpb)"));
+    if(!fileName.isEmpty())
     {
-        QFile::remove(_programBankFileName);
+        _minotor->saveToFile(_minotor->programBank(), fileName, Minotor::IniFormat);
     }
-    QSettings parser(_programBankFileName, QSettings::IniFormat);
-    _minotor->save(_minotor->programBank(), &parser);
 }
 
 void MainWindow::on_actionNewProgram_triggered()
@@ -395,8 +420,7 @@ void MainWindow::on_actionImport_triggered()
 {
     QString dataPath = Minotor::dataPath();
     QString fileName = QFileDialog::getOpenFileName(this, tr("Load File"), dataPath,tr(" (*.mpr)"));
-    QSettings parser(fileName, QSettings::IniFormat);
-    _minotor->load(&parser);
+    _minotor->loadFromFile(fileName);
 }
 
 void MainWindow::on_sPpqn_valueChanged(int value)
@@ -485,6 +509,29 @@ void MainWindow::on_actionExternal_master_view_toggled(bool on)
     _externalMasterView->setVisible(on);
 }
 
+void MainWindow::on_actionPerformance_HUD_toggled(bool on)
+{
+    _uiPerformanceHud->setVisible(on);
+}
+
+void MainWindow::on_actionRecord_trace_toggled(bool on)
+{
+    MinoTraceRecorder *recorder = MinoTraceRecorder::recorder();
+    if(on)
+    {
+        recorder->start();
+    }
+    else
+    {
+        recorder->stop();
+        const QString fileName = QFileDialog::getSaveFileName(this, tr("Save trace"), Minotor::dataPath(), tr("Chrome trace (*.json)"));
+        if(!fileName.isEmpty() && !recorder->dump(fileName))
+        {
+            QMessageBox::warning(this, tr("Save trace"), tr("Unable to write %1").arg(fileName));
+        }
+    }
+}
+
 void MainWindow::on_actionNew_triggered()
 {
     QMessageBox::StandardButton ret = QMessageBox::question(this,"Create a new program bank","This will erase you current bank.",QMessageBox::Ok | QMessageBox::Cancel,QMessageBox::Ok);
@@ -28,6 +28,7 @@
 #include "externalmasterview.h"
 #include "uiprogrameditor.h"
 #include "uimaster.h"
+#include "uiperformancehud.h"
 
 #include "minotor.h"
 #include "ledmatrix.h"
@@ -64,6 +65,7 @@ private slots:
     void on_actionSave_triggered();
     // UI: Program Bank/SaveAs
     void on_actionSaveAs_triggered();
+    void on_actionExportIni_triggered();
     // UI: Add new program to bank
     void on_actionNewProgram_triggered();
     // UI: Import Program
@@ -84,6 +86,8 @@ private slots:
     void midiDataReceived();
 
     void on_actionExternal_master_view_toggled(bool on);
+    void on_actionPerformance_HUD_toggled(bool on);
+    void on_actionRecord_trace_toggled(bool on);
 
     void on_actionNew_triggered();
 
@@ -113,6 +117,9 @@ private:
     // External master view
     ExternalMasterView *_externalMasterView;
 
+    // Frame timings overlay
+    UiPerformanceHud *_uiPerformanceHud;
+
     // Current ProgramBankFile
     QString _programBankFileName;
 
@@ -24,14 +24,19 @@
 #include <QDebug>
 
 #include "minotor.h"
+#include "minoprofiler.h"
 
 int main(int argc, char *argv[])
 {
+    // Startup timings are relative to this point
+    MinoProfiler::profiler()->mark("process started");
+
     QApplication a(argc, argv);
 
     // Auto-create minotor instance
     Minotor *minotor = Minotor::minotor();
     minotor->loadSettings();
+    MinoProfiler::profiler()->mark("settings loaded");
 
     // HACK
     qDebug() << "";
@@ -47,11 +52,13 @@ int main(int argc, char *argv[])
     // Apply the loaded stylesheet
     QString style( styleFile.readAll() );
     a.setStyleSheet( style );
+    MinoProfiler::profiler()->mark("style sheet applied");
     // a.setOrganizationName(); ???
     a.setApplicationName("Minotor");
 
     MainWindow w;
     w.show();
+    MinoProfiler::profiler()->mark("main window shown");
 
     int ret = a.exec();
 
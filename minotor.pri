@@ -0,0 +1,175 @@
+#-------------------------------------------------
+#
+# Minotor core: engine, animations and programs
+# (shared by GUI and headless targets)
+#
+#-------------------------------------------------
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += concurrent
+
+SOURCES += \
+    $$PWD/Animation/minaballs.cpp \
+    $$PWD/Animation/minabarsfromsides.cpp \
+    $$PWD/Animation/minacurve.cpp \
+    $$PWD/Animation/minadebug.cpp \
+    $$PWD/Animation/minaexpandingobjects.cpp \
+    $$PWD/Animation/minafallingobjects.cpp \
+    $$PWD/Animation/minaflash.cpp \
+    $$PWD/Animation/minaflashbars.cpp \
+    $$PWD/Animation/minagradient.cpp \
+    $$PWD/Animation/minagrid.cpp \
+    $$PWD/Animation/minaimage.cpp \
+    $$PWD/Animation/minaplasma.cpp \
+    $$PWD/Animation/minarainbowoil.cpp \
+    $$PWD/Animation/minarandompixels.cpp \
+    $$PWD/Animation/minarotatingbars.cpp \
+    $$PWD/Animation/minastars.cpp \
+    $$PWD/Animation/minatext.cpp \
+    $$PWD/Animation/minavibration.cpp \
+    $$PWD/Animation/minawaveform.cpp \
+    $$PWD/Core/Midi/midi.cpp \
+    $$PWD/Core/Midi/midicontrol.cpp \
+    $$PWD/Core/Midi/midicontrollablelist.cpp \
+    $$PWD/Core/Midi/midicontrollableparameter.cpp \
+    $$PWD/Core/Midi/midicontrollablereal.cpp \
+    $$PWD/Core/Midi/mididevicewatcher.cpp \
+    $$PWD/Core/Midi/midifeedbackqueue.cpp \
+    $$PWD/Core/Midi/midiinterface.cpp \
+    $$PWD/Core/Midi/midimapper.cpp \
+    $$PWD/Core/Midi/midimapping.cpp \
+    $$PWD/Core/Midi/midirecorder.cpp \
+    $$PWD/Core/Midi/midireplayer.cpp \
+    $$PWD/Core/Property/minoitemizedproperty.cpp \
+    $$PWD/Core/Property/minoproperty.cpp \
+    $$PWD/Core/Property/minopropertybeat.cpp \
+    $$PWD/Core/Property/minopropertycolor.cpp \
+    $$PWD/Core/Property/minopropertyeasingcurve.cpp \
+    $$PWD/Core/Property/minopropertyfilename.cpp \
+    $$PWD/Core/Property/minopropertyreal.cpp \
+    $$PWD/Core/Property/minopropertytext.cpp \
+    $$PWD/Core/easingcurvedreal.cpp \
+    $$PWD/Core/ledcolorpipeline.cpp \
+    $$PWD/Core/ledmatrix.cpp \
+    $$PWD/Core/minoanimation.cpp \
+    $$PWD/Core/minoanimationgroup.cpp \
+    $$PWD/Core/minobinarybank.cpp \
+    $$PWD/Core/minoclocksource.cpp \
+    $$PWD/Core/minoimageitem.cpp \
+    $$PWD/Core/minocompositor.cpp \
+    $$PWD/Core/minocontrol.cpp \
+    $$PWD/Core/minodownsampler.cpp \
+    $$PWD/Core/minoframedumper.cpp \
+    $$PWD/Core/minoglyphatlas.cpp \
+    $$PWD/Core/minoinstrumentedanimation.cpp \
+    $$PWD/Core/minoitempainter.cpp \
+    $$PWD/Core/minomaster.cpp \
+    $$PWD/Core/minomastermidimapper.cpp \
+    $$PWD/Core/minopersistentobject.cpp \
+    $$PWD/Core/minopersistentobjectfactory.cpp \
+    $$PWD/Core/minoprofiler.cpp \
+    $$PWD/Core/minoprogram.cpp \
+    $$PWD/Core/minoprogrambank.cpp \
+    $$PWD/Core/minoprogrambankloader.cpp \
+    $$PWD/Core/minopropertymidichannel.cpp \
+    $$PWD/Core/minorandom.cpp \
+    $$PWD/Core/minothumbnailservice.cpp \
+    $$PWD/Core/minotor.cpp \
+    $$PWD/Core/minotracerecorder.cpp \
+    $$PWD/Core/minotrigger.cpp \
+    $$PWD/miprodebug.cpp
+
+HEADERS += \
+    $$PWD/Animation/minaballs.h \
+    $$PWD/Animation/minabarsfromsides.h \
+    $$PWD/Animation/minacurve.h \
+    $$PWD/Animation/minadebug.h \
+    $$PWD/Animation/minaexpandingobjects.h \
+    $$PWD/Animation/minafallingobjects.h \
+    $$PWD/Animation/minaflash.h \
+    $$PWD/Animation/minaflashbars.h \
+    $$PWD/Animation/minagradient.h \
+    $$PWD/Animation/minagrid.h \
+    $$PWD/Animation/minaimage.h \
+    $$PWD/Animation/minaplasma.h \
+    $$PWD/Animation/minarainbowoil.h \
+    $$PWD/Animation/minarandompixels.h \
+    $$PWD/Animation/minarotatingbars.h \
+    $$PWD/Animation/minastars.h \
+    $$PWD/Animation/minatext.h \
+    $$PWD/Animation/minavibration.h \
+    $$PWD/Animation/minawaveform.h \
+    $$PWD/Core/Midi/midi.h \
+    $$PWD/Core/Midi/midicontrol.h \
+    $$PWD/Core/Midi/midicontrollablelist.h \
+    $$PWD/Core/Midi/midicontrollableparameter.h \
+    $$PWD/Core/Midi/midicontrollablereal.h \
+    $$PWD/Core/Midi/mididevicewatcher.h \
+    $$PWD/Core/Midi/midifeedbackqueue.h \
+    $$PWD/Core/Midi/midiinterface.h \
+    $$PWD/Core/Midi/midimapper.h \
+    $$PWD/Core/Midi/midimapping.h \
+    $$PWD/Core/Midi/midirecorder.h \
+    $$PWD/Core/Midi/midireplayer.h \
+    $$PWD/Core/Property/minoitemizedproperty.h \
+    $$PWD/Core/Property/minoproperty.h \
+    $$PWD/Core/Property/minopropertybeat.h \
+    $$PWD/Core/Property/minopropertycolor.h \
+    $$PWD/Core/Property/minopropertyeasingcurve.h \
+    $$PWD/Core/Property/minopropertyfilename.h \
+    $$PWD/Core/Property/minopropertyreal.h \
+    $$PWD/Core/Property/minopropertytext.h \
+    $$PWD/Core/easingcurvedreal.h \
+    $$PWD/Core/ledcolorpipeline.h \
+    $$PWD/Core/ledmatrix.h \
+    $$PWD/Core/minoanimation.h \
+    $$PWD/Core/minoanimationgroup.h \
+    $$PWD/Core/minobinarybank.h \
+    $$PWD/Core/minoclocksource.h \
+    $$PWD/Core/minoimageitem.h \
+    $$PWD/Core/minocompositor.h \
+    $$PWD/Core/minocontrol.h \
+    $$PWD/Core/minodownsampler.h \
+    $$PWD/Core/minoframedumper.h \
+    $$PWD/Core/minoglyphatlas.h \
+    $$PWD/Core/minoinstrumentedanimation.h \
+    $$PWD/Core/minoitempainter.h \
+    $$PWD/Core/minomaster.h \
+    $$PWD/Core/minomastermidimapper.h \
+    $$PWD/Core/minonulldevice.h \
+    $$PWD/Core/minopersistentobject.h \
+    $$PWD/Core/minopersistentobjectfactory.h \
+    $$PWD/Core/minoprofiler.h \
+    $$PWD/Core/minoprogram.h \
+    $$PWD/Core/minoprogrambank.h \
+    $$PWD/Core/minoprogrambankloader.h \
+    $$PWD/Core/minopropertymidichannel.h \
+    $$PWD/Core/minorandom.h \
+    $$PWD/Core/minothumbnailservice.h \
+    $$PWD/Core/minotor.h \
+    $$PWD/Core/minotracerecorder.h \
+    $$PWD/Core/minotrigger.h \
+    $$PWD/miprobnzichru.h \
+    $$PWD/miprodebug.h \
+    $$PWD/mipromatrix.h \
+    $$PWD/miprosecondlives.h \
+    $$PWD/miprowaves.h
+
+INCLUDEPATH += \
+    $$PWD \
+    $$PWD/Animation \
+    $$PWD/Core \
+    $$PWD/Core/Midi \
+    $$PWD/Core/Property
+
+packagesExist(rtmidi) {
+  PKGCONFIG += rtmidi
+} else {
+  include($$PWD/libraries/rtmidi/rtmidi.pri)
+}
+
+unix {
+  CONFIG += link_pkgconfig
+  CONFIG += extserialport
+} else {
+  include($$PWD/libraries/qextserialport/src/qextserialport.pri)
+}